@@ -66,10 +66,20 @@ class LibresFacade:
         return self._enkf_main.getModelConfig().getRunpathAsString()
 
     def load_from_forward_model(
-        self, case: str, realisations: List[bool], iteration: int
+        self,
+        case: str,
+        realisations: List[bool],
+        iteration: int,
+        force_reload: bool = False,
     ) -> int:
+        """Loads the results of the realisations into case, and returns the
+        number of loaded realisations. Results which are unchanged since they
+        were last loaded into case are not loaded again, unless force_reload
+        is True."""
         fs = self._enkf_main.getEnkfFsManager().getFileSystem(case)
-        return self._enkf_main.loadFromForwardModel(realisations, iteration, fs)
+        return self._enkf_main.loadFromForwardModel(
+            realisations, iteration, fs, force_reload
+        )
 
     def get_observations(self):
         return self._enkf_main.getObservations()
@@ -1,4 +1,5 @@
 #include <Eigen/Dense>
+#include <algorithm>
 #include <assert.h>
 #include <cerrno>
 #include <fmt/format.h>
@@ -34,6 +35,151 @@ bool_vector_to_active_list(const std::vector<bool> &bool_vector) {
 }
 } // namespace
 
+/**
+ Replaces blocks of block_size consecutive observations with their average. For
+ independent errors the error of an average over n elements is
+ sqrt(sum(std_i^2)) / n.
+*/
+ReducedObservations
+reduce_block_average(const Eigen::Ref<const Eigen::MatrixXd> &S,
+                     const Eigen::Ref<const Eigen::VectorXd> &values,
+                     const Eigen::Ref<const Eigen::VectorXd> &errors,
+                     int block_size) {
+    int size = values.size();
+    int reduced_size = (size + block_size - 1) / block_size;
+    ReducedObservations reduced{Eigen::MatrixXd(reduced_size, S.cols()),
+                                Eigen::VectorXd(reduced_size),
+                                Eigen::VectorXd(reduced_size)};
+    for (int j = 0; j < reduced_size; j++) {
+        int start = j * block_size;
+        int n = std::min(block_size, size - start);
+        reduced.S.row(j) = S.middleRows(start, n).colwise().mean();
+        reduced.values(j) = values.segment(start, n).mean();
+        reduced.errors(j) = errors.segment(start, n).norm() / n;
+    }
+    return reduced;
+}
+
+/**
+ Projects the observations onto the leading principal components of the error
+ normalised ensemble anomalies. With W = diag(1 / errors) and U the orthonormal
+ leading left singular vectors of the anomalies of W S, the reduced quantities
+ are U^T W S and U^T W d, and the transformed error covariance
+ U^T W R W U = I. The principal components are found from the small
+ ens_size x ens_size Gram matrix, so the cost is linear in the number of
+ observations.
+
+ Returns an empty optional when the group can not be reduced, i.e. there is no
+ ensemble spread or all components are needed.
+*/
+std::optional<ReducedObservations>
+reduce_principal_components(const Eigen::Ref<const Eigen::MatrixXd> &S,
+                            const Eigen::Ref<const Eigen::VectorXd> &values,
+                            const Eigen::Ref<const Eigen::VectorXd> &errors,
+                            double variance_fraction) {
+    Eigen::VectorXd inv_errors = errors.cwiseInverse();
+    Eigen::MatrixXd Sw = inv_errors.asDiagonal() * S;
+    Eigen::MatrixXd anomalies = Sw.colwise() - Sw.rowwise().mean();
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen_solver(
+        anomalies.transpose() * anomalies);
+    // The eigenvalues are sorted in increasing order
+    const Eigen::VectorXd &eigenvalues = eigen_solver.eigenvalues();
+    int ens_size = eigenvalues.size();
+    double largest = ens_size > 0 ? eigenvalues(ens_size - 1) : 0;
+    if (largest <= 0)
+        return {};
+
+    double total = eigenvalues.cwiseMax(0).sum();
+    double retained = 0;
+    int num_components = 0;
+    while (num_components < ens_size && retained < variance_fraction * total) {
+        double eigenvalue = eigenvalues(ens_size - 1 - num_components);
+        if (eigenvalue <= largest * Eigen::NumTraits<double>::epsilon())
+            break;
+        retained += eigenvalue;
+        num_components++;
+    }
+    if (num_components >= values.size())
+        return {};
+
+    Eigen::MatrixXd V = eigen_solver.eigenvectors()
+                            .rightCols(num_components)
+                            .rowwise()
+                            .reverse();
+    Eigen::VectorXd inv_sigma =
+        eigenvalues.tail(num_components).reverse().cwiseSqrt().cwiseInverse();
+    Eigen::MatrixXd U = anomalies * V * inv_sigma.asDiagonal();
+
+    return ReducedObservations{
+        U.transpose() * Sw, U.transpose() * inv_errors.cwiseProduct(values),
+        Eigen::VectorXd::Ones(num_components)};
+}
+
+/**
+ Applies the observation reduction group by group; groups which are too small,
+ or can not be reduced, are kept as they are.
+*/
+void reduce_observations(const ObservationReduction &reduction,
+                         const std::vector<ObservationGroup> &groups,
+                         Eigen::MatrixXd &S, Eigen::VectorXd &values,
+                         Eigen::VectorXd &errors) {
+    std::vector<std::optional<ReducedObservations>> reduced_groups;
+    int reduced_size = 0;
+    for (const auto &group : groups) {
+        std::optional<ReducedObservations> reduced;
+        if (group.size >= reduction.min_size) {
+            auto group_S = S.middleRows(group.row_offset, group.size);
+            auto group_values = values.segment(group.row_offset, group.size);
+            auto group_errors = errors.segment(group.row_offset, group.size);
+            if (reduction.block_size > 0)
+                reduced = reduce_block_average(group_S, group_values,
+                                               group_errors,
+                                               reduction.block_size);
+            else
+                reduced = reduce_principal_components(
+                    group_S, group_values, group_errors,
+                    reduction.variance_fraction);
+        }
+
+        int size = reduced ? reduced->values.size() : group.size;
+        if (reduced)
+            logger->info("Observation reduction of {}: {} -> {} rows "
+                         "(ratio {:.1f})",
+                         group.key, group.size, size,
+                         static_cast<double>(group.size) / size);
+        reduced_size += size;
+        reduced_groups.push_back(std::move(reduced));
+    }
+
+    Eigen::MatrixXd reduced_S(reduced_size, S.cols());
+    Eigen::VectorXd reduced_values(reduced_size);
+    Eigen::VectorXd reduced_errors(reduced_size);
+    int row = 0;
+    for (size_t i = 0; i < groups.size(); i++) {
+        const auto &group = groups[i];
+        const auto &reduced = reduced_groups[i];
+        if (reduced) {
+            int size = reduced->values.size();
+            reduced_S.middleRows(row, size) = reduced->S;
+            reduced_values.segment(row, size) = reduced->values;
+            reduced_errors.segment(row, size) = reduced->errors;
+            row += size;
+        } else {
+            reduced_S.middleRows(row, group.size) =
+                S.middleRows(group.row_offset, group.size);
+            reduced_values.segment(row, group.size) =
+                values.segment(group.row_offset, group.size);
+            reduced_errors.segment(row, group.size) =
+                errors.segment(group.row_offset, group.size);
+            row += group.size;
+        }
+    }
+    S = std::move(reduced_S);
+    values = std::move(reduced_values);
+    errors = std::move(reduced_errors);
+}
+
 /**
  This is very awkward; the problem is that for the GEN_DATA type the config
  object does not really own the size. Instead the size is pushed (on load time)
@@ -282,7 +428,8 @@ std::pair<Eigen::MatrixXd, ObservationHandler> load_observations_and_responses(
     double std_cutoff, double global_std_scaling,
     const std::vector<bool> &ens_mask,
     const std::vector<std::pair<std::string, std::vector<int>>>
-        &selected_observations) {
+        &selected_observations,
+    const ObservationReduction &reduction = {}) {
     /*
     Observations and measurements are collected in these temporary
     structures. obs_data is a precursor for the 'd' vector, and
@@ -317,6 +464,24 @@ std::pair<Eigen::MatrixXd, ObservationHandler> load_observations_and_responses(
         obs_data_errors_as_vector(obs_data) * sqrt(global_std_scaling);
     std::vector<bool> obs_mask = obs_data_get_active_mask(obs_data);
 
+    if (reduction.enabled()) {
+        std::vector<ObservationGroup> groups;
+        int row_offset = 0;
+        for (int block_nr = 0; block_nr < obs_data_get_num_blocks(obs_data);
+             block_nr++) {
+            const obs_block_type *obs_block =
+                obs_data_iget_block_const(obs_data, block_nr);
+            int active_size = obs_block_get_active_size(obs_block);
+            groups.push_back(
+                {obs_block_get_key(obs_block), row_offset, active_size});
+            row_offset += active_size;
+        }
+        reduce_observations(reduction, groups, S, observation_values,
+                            observation_errors);
+        // All rows in the reduced observation space are active
+        obs_mask.assign(observation_values.size(), true);
+    }
+
     return std::pair<Eigen::MatrixXd, ObservationHandler>(
         S, ObservationHandler(observation_values, observation_errors, obs_mask,
                               update_snapshot));
@@ -351,14 +516,29 @@ load_observations_and_responses_pybind(
     py::object source_fs, py::object obs, double alpha, double std_cutoff,
     double global_std_scaling, std::vector<bool> ens_mask,
     const std::vector<std::pair<std::string, std::vector<int>>>
-        &selected_observations) {
+        &selected_observations,
+    const analysis::ObservationReduction &reduction) {
 
     auto source_fs_ = ert::from_cwrap<enkf_fs_type>(source_fs);
     auto obs_ = ert::from_cwrap<enkf_obs_type>(obs);
 
     return analysis::load_observations_and_responses(
         source_fs_, obs_, alpha, std_cutoff, global_std_scaling, ens_mask,
-        selected_observations);
+        selected_observations, reduction);
+}
+
+static analysis::ObservationReduction
+observation_reduction_pybind(py::object analysis_config) {
+    auto analysis_config_ =
+        ert::from_cwrap<analysis_config_type>(analysis_config);
+    analysis::ObservationReduction reduction;
+    reduction.min_size =
+        analysis_config_get_obs_reduction_min_size(analysis_config_);
+    reduction.block_size =
+        analysis_config_get_obs_reduction_block_size(analysis_config_);
+    reduction.variance_fraction =
+        analysis_config_get_obs_reduction_variance(analysis_config_);
+    return reduction;
 }
 
 static std::vector<std::pair<Eigen::MatrixXd, std::shared_ptr<RowScaling>>>
@@ -459,8 +639,20 @@ RES_LIB_SUBMODULE("update", m) {
         .def_readwrite("update_snapshot",
                        &analysis::ObservationHandler::update_snapshot);
     m.def("copy_parameters", copy_parameters_pybind);
+    py::class_<analysis::ObservationReduction>(m, "ObservationReduction")
+        .def(py::init<>())
+        .def_readwrite("min_size", &analysis::ObservationReduction::min_size)
+        .def_readwrite("block_size",
+                       &analysis::ObservationReduction::block_size)
+        .def_readwrite("variance_fraction",
+                       &analysis::ObservationReduction::variance_fraction);
     m.def("load_observations_and_responses",
-          load_observations_and_responses_pybind);
+          load_observations_and_responses_pybind, py::arg("source_fs"),
+          py::arg("obs"), py::arg("alpha"), py::arg("std_cutoff"),
+          py::arg("global_std_scaling"), py::arg("ens_mask"),
+          py::arg("selected_observations"),
+          py::arg("reduction") = analysis::ObservationReduction());
+    m.def("observation_reduction", observation_reduction_pybind);
     m.def("save_parameters", save_parameters_pybind);
     m.def("save_row_scaling_parameters", save_row_scaling_parameters_pybind);
     m.def("load_parameters", load_parameters_pybind);
@@ -41,6 +41,9 @@
 
 #define UPDATE_ENKF_ALPHA_KEY "ENKF_ALPHA"
 #define UPDATE_STD_CUTOFF_KEY "STD_CUTOFF"
+#define UPDATE_OBS_REDUCTION_MIN_SIZE_KEY "OBS_REDUCTION_MIN_SIZE"
+#define UPDATE_OBS_REDUCTION_BLOCK_SIZE_KEY "OBS_REDUCTION_BLOCK_SIZE"
+#define UPDATE_OBS_REDUCTION_VARIANCE_KEY "OBS_REDUCTION_VARIANCE"
 
 #define ANALYSIS_CONFIG_TYPE_ID 64431306
 
@@ -179,6 +182,49 @@ double analysis_config_get_std_cutoff(const analysis_config_type *config) {
     return config_settings_get_double_value(config->update_settings,
                                             UPDATE_STD_CUTOFF_KEY);
 }
+
+/**
+   Observation groups with at least this many active elements are
+   reduced before the update; zero disables the reduction.
+*/
+int analysis_config_get_obs_reduction_min_size(
+    const analysis_config_type *config) {
+    return config_settings_get_double_value(config->update_settings,
+                                            UPDATE_OBS_REDUCTION_MIN_SIZE_KEY);
+}
+
+/**
+   When positive, reduced observation groups are replaced by averages
+   over blocks of this many consecutive elements instead of their
+   leading principal components.
+*/
+int analysis_config_get_obs_reduction_block_size(
+    const analysis_config_type *config) {
+    return config_settings_get_double_value(
+        config->update_settings, UPDATE_OBS_REDUCTION_BLOCK_SIZE_KEY);
+}
+
+/**
+   Fraction of the ensemble variance retained by the principal component
+   reduction.
+*/
+double analysis_config_get_obs_reduction_variance(
+    const analysis_config_type *config) {
+    return config_settings_get_double_value(config->update_settings,
+                                            UPDATE_OBS_REDUCTION_VARIANCE_KEY);
+}
+
+static void analysis_config_add_obs_reduction_settings(
+    analysis_config_type *config, int min_size, int block_size,
+    double variance) {
+    config_settings_add_double_setting(
+        config->update_settings, UPDATE_OBS_REDUCTION_MIN_SIZE_KEY, min_size);
+    config_settings_add_double_setting(config->update_settings,
+                                       UPDATE_OBS_REDUCTION_BLOCK_SIZE_KEY,
+                                       block_size);
+    config_settings_add_double_setting(
+        config->update_settings, UPDATE_OBS_REDUCTION_VARIANCE_KEY, variance);
+}
 void analysis_config_set_log_path(analysis_config_type *config,
                                   const char *log_path) {
     config->log_path = util_realloc_string_copy(config->log_path, log_path);
@@ -468,7 +514,9 @@ void analysis_config_free(analysis_config_type *config) {
 analysis_config_type *analysis_config_alloc_full(
     double alpha, bool rerun, int rerun_start, const char *log_path,
     double std_cutoff, bool stop_long_running, bool single_node_update,
-    double global_std_scaling, int max_runtime, int min_realisations) {
+    double global_std_scaling, int max_runtime, int min_realisations,
+    int obs_reduction_min_size, int obs_reduction_block_size,
+    double obs_reduction_variance) {
     analysis_config_type *config = new analysis_config_type();
     UTIL_TYPE_ID_INIT(config, ANALYSIS_CONFIG_TYPE_ID);
 
@@ -478,6 +526,9 @@ analysis_config_type *analysis_config_alloc_full(
                                        UPDATE_ENKF_ALPHA_KEY, alpha);
     config_settings_add_double_setting(config->update_settings,
                                        UPDATE_STD_CUTOFF_KEY, std_cutoff);
+    analysis_config_add_obs_reduction_settings(
+        config, obs_reduction_min_size, obs_reduction_block_size,
+        obs_reduction_variance);
 
     config->rerun = rerun;
     config->rerun_start = rerun_start;
@@ -506,6 +557,9 @@ analysis_config_type *analysis_config_alloc_default(void) {
     config_settings_add_double_setting(config->update_settings,
                                        UPDATE_STD_CUTOFF_KEY,
                                        DEFAULT_ENKF_STD_CUTOFF);
+    analysis_config_add_obs_reduction_settings(
+        config, DEFAULT_OBS_REDUCTION_MIN_SIZE,
+        DEFAULT_OBS_REDUCTION_BLOCK_SIZE, DEFAULT_OBS_REDUCTION_VARIANCE);
 
     analysis_config_set_rerun(config, DEFAULT_RERUN);
     analysis_config_set_rerun_start(config, DEFAULT_RERUN_START);
@@ -29,6 +29,8 @@ namespace fs = std::filesystem;
 #include <ert/util/buffer.h>
 #include <ert/util/util.h>
 
+#include <fmt/format.h>
+
 #include <ert/res_util/block_fs.hpp>
 
 #include <ert/enkf/block_fs_driver.hpp>
@@ -139,6 +141,20 @@ void ert::block_fs_driver::load_vector(const char *node_key, int iens,
     free(key);
 }
 
+/**
+   Reads byte_size bytes starting at offset into the stored vector, without
+   loading the rest of it.
+*/
+void ert::block_fs_driver::load_vector_range(const char *node_key, int iens,
+                                             size_t offset, void *ptr,
+                                             size_t byte_size) {
+    char *key = block_fs_driver_alloc_vector_key(node_key, iens);
+    bfs_type *bfs = this->get_fs(iens);
+
+    block_fs_fread_range(bfs->block_fs, key, offset, ptr, byte_size);
+    free(key);
+}
+
 void ert::block_fs_driver::save_node(const char *node_key, int report_step,
                                      int iens, buffer_type *buffer) {
     char *key = block_fs_driver_alloc_node_key(node_key, report_step, iens);
@@ -172,6 +188,97 @@ bool ert::block_fs_driver::has_vector(const char *node_key, int iens) {
     return has_node;
 }
 
+/**
+   The keys are grouped per block_fs instance in fs_keys, in the order they
+   appear in iens_list. Each block_fs instance is queried once, and the
+   result is assembled back to the order of iens_list.
+*/
+std::vector<bool> ert::block_fs_driver::has_files(
+    const std::vector<int> &iens_list,
+    const std::vector<std::vector<std::string>> &fs_keys) {
+    std::vector<std::vector<bool>> fs_result(this->num_fs);
+    for (int ifs = 0; ifs < this->num_fs; ifs++) {
+        if (!fs_keys[ifs].empty())
+            fs_result[ifs] =
+                block_fs_has_files(this->fs_list[ifs]->block_fs, fs_keys[ifs]);
+    }
+
+    std::vector<size_t> fs_pos(this->num_fs, 0);
+    std::vector<bool> has_file(iens_list.size());
+    for (size_t i = 0; i < iens_list.size(); i++) {
+        int phase = iens_list[i] % this->num_fs;
+        has_file[i] = fs_result[phase][fs_pos[phase]++];
+    }
+    return has_file;
+}
+
+/**
+   Bulk version of has_node(); element i in the return value tells whether
+   node_key is stored for node_ids[i].
+*/
+std::vector<bool>
+ert::block_fs_driver::has_nodes(const char *node_key,
+                                const std::vector<node_id_type> &node_ids) {
+    std::vector<int> iens_list;
+    std::vector<std::vector<std::string>> fs_keys(this->num_fs);
+    iens_list.reserve(node_ids.size());
+    for (const auto &node_id : node_ids) {
+        iens_list.push_back(node_id.iens);
+        fs_keys[node_id.iens % this->num_fs].push_back(fmt::format(
+            "{}.{}.{}", node_key, node_id.report_step, node_id.iens));
+    }
+    return this->has_files(iens_list, fs_keys);
+}
+
+/**
+   Bulk version of has_vector(); element i in the return value tells whether
+   the vector node_key is stored for realization iens_list[i].
+*/
+std::vector<bool>
+ert::block_fs_driver::has_vectors(const char *node_key,
+                                  const std::vector<int> &iens_list) {
+    std::vector<std::vector<std::string>> fs_keys(this->num_fs);
+    for (int iens : iens_list)
+        fs_keys[iens % this->num_fs].push_back(
+            fmt::format("{}.{}", node_key, iens));
+    return this->has_files(iens_list, fs_keys);
+}
+
+/**
+   Bulk version of load_node(); node_keys[i] of node_ids[i] is read into
+   buffers[i], and element i in the return value tells whether it is stored.
+   Each block_fs instance is read once, in the order of the data file.
+*/
+std::vector<bool>
+ert::block_fs_driver::load_nodes(const std::vector<std::string> &node_keys,
+                                 const std::vector<node_id_type> &node_ids,
+                                 const std::vector<buffer_type *> &buffers) {
+    std::vector<std::vector<std::string>> fs_keys(this->num_fs);
+    std::vector<std::vector<buffer_type *>> fs_buffers(this->num_fs);
+    for (size_t i = 0; i < node_keys.size(); i++) {
+        int phase = node_ids[i].iens % this->num_fs;
+        fs_keys[phase].push_back(fmt::format("{}.{}.{}", node_keys[i],
+                                             node_ids[i].report_step,
+                                             node_ids[i].iens));
+        fs_buffers[phase].push_back(buffers[i]);
+    }
+
+    std::vector<std::vector<bool>> fs_result(this->num_fs);
+    for (int ifs = 0; ifs < this->num_fs; ifs++) {
+        if (!fs_keys[ifs].empty())
+            fs_result[ifs] = block_fs_fread_files(
+                this->fs_list[ifs]->block_fs, fs_keys[ifs], fs_buffers[ifs]);
+    }
+
+    std::vector<size_t> fs_pos(this->num_fs, 0);
+    std::vector<bool> has_node(node_ids.size());
+    for (size_t i = 0; i < node_ids.size(); i++) {
+        int phase = node_ids[i].iens % this->num_fs;
+        has_node[i] = fs_result[phase][fs_pos[phase]++];
+    }
+    return has_node;
+}
+
 ert::block_fs_driver::~block_fs_driver() {
     // Sometimes only one is managed, so no need to spin up parallelism
     if (this->num_fs == 1) {
@@ -73,6 +73,9 @@ RES_LIB_SUBMODULE("config_keys", m) {
     cls.attr("NUM_CPU") = NUM_CPU_KEY;
     cls.attr("NUM_REALIZATIONS") = NUM_REALIZATIONS_KEY;
     cls.attr("OBS_CONFIG") = OBS_CONFIG_KEY;
+    cls.attr("OBS_REDUCTION_BLOCK_SIZE") = OBS_REDUCTION_BLOCK_SIZE_KEY;
+    cls.attr("OBS_REDUCTION_MIN_SIZE") = OBS_REDUCTION_MIN_SIZE_KEY;
+    cls.attr("OBS_REDUCTION_VARIANCE") = OBS_REDUCTION_VARIANCE_KEY;
     cls.attr("OPTION") = "OPTION";
     cls.attr("OUTPUT_FORMAT") = OUTPUT_FORMAT_KEY;
     cls.attr("OUTPUT_TRANSFORM") = OUTPUT_TRANSFORM_KEY;
@@ -120,6 +123,7 @@ RES_LIB_SUBMODULE("config_keys", m) {
     cls.attr("STD_CUTOFF_KEY") = STD_CUTOFF_KEY;
     cls.attr("STOP_LONG_RUNNING") = STOP_LONG_RUNNING_KEY;
     cls.attr("SUMMARY") = SUMMARY_KEY;
+    cls.attr("SUMMARY_TABLE") = SUMMARY_TABLE_KEY;
     cls.attr("SURFACE_KEY") = SURFACE_KEY;
     cls.attr("TEMPLATE") = TEMPLATE_KEY;
     cls.attr("TIME_MAP") = TIME_MAP_KEY;
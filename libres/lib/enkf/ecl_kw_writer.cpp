@@ -0,0 +1,306 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'ecl_kw_writer.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ert/ecl/ecl_endian_flip.h>
+#include <ert/util/util.h>
+
+#include <ert/enkf/ecl_kw_writer.hpp>
+
+namespace {
+
+/* The number of elements in each record of a keyword, as in libecl. */
+constexpr int block_size = 1000;
+
+/* The formatted text is written to the stream in chunks of this size. */
+constexpr size_t chunk_size = 1 << 20;
+
+/**
+   The format of the floating point numbers in the GRDECL format, which
+   libecl writes as printf(printf_format, mantissa, exponent) where the
+   absolute value of the mantissa is in (0.1, 1].
+*/
+struct scientific_format {
+    int columns;
+    int width;
+    int decimals;
+    char exponent_char;
+    const char *printf_format;
+};
+
+constexpr scientific_format float_format = {4, 11, 8, 'E', "  %11.8fE%+03d"};
+constexpr scientific_format double_format = {3, 22, 14, 'D',
+                                             "  %22.14fD%+03d"};
+constexpr int int_columns = 6;
+constexpr int int_width = 11;
+
+/**
+   pow(10.0, exponent); the integer exponents which occur for the finite
+   numbers are looked up in a table computed with pow(), so the result is
+   bit identical to calling pow().
+*/
+double power_of_ten(double exponent) {
+    constexpr int min_exponent = -330;
+    constexpr int max_exponent = 310;
+    static const std::vector<double> table = [] {
+        std::vector<double> table;
+        for (int exp = min_exponent; exp <= max_exponent; exp++)
+            table.push_back(pow(10.0, exp));
+        return table;
+    }();
+
+    if (exponent >= min_exponent && exponent <= max_exponent)
+        return table[static_cast<int>(exponent) - min_exponent];
+    return pow(10.0, exponent);
+}
+
+/**
+   Writes value right aligned in width with the given number of decimals,
+   exactly as printf("%*.*f") with the default rounding. Returns the end of
+   the text, or nullptr for the values which are not handled: the non
+   finite values and |value| >= 10.
+*/
+char *format_fixed(char *out, double value, int width, int decimals) {
+    static constexpr uint64_t pow10[] = {1,
+                                         10,
+                                         100,
+                                         1000,
+                                         10000,
+                                         100000,
+                                         1000000,
+                                         10000000,
+                                         100000000,
+                                         1000000000,
+                                         10000000000,
+                                         100000000000,
+                                         1000000000000,
+                                         10000000000000,
+                                         100000000000000,
+                                         1000000000000000};
+    if (!(fabs(value) < 10.0) || decimals > 15)
+        return nullptr;
+
+    // |value| = mantissa * 2^-shift, which is scaled with 10^decimals and
+    // rounded to the nearest integer, with ties to even.
+    uint64_t digits = 0;
+    int exponent;
+    double fraction = frexp(fabs(value), &exponent);
+    if (fraction != 0) {
+        uint64_t mantissa = static_cast<uint64_t>(ldexp(fraction, 53));
+        int shift = 53 - exponent;
+        if (shift >= 127)
+            return nullptr;
+
+        unsigned __int128 scaled =
+            static_cast<unsigned __int128>(mantissa) * pow10[decimals];
+        unsigned __int128 half = static_cast<unsigned __int128>(1)
+                                 << (shift - 1);
+        unsigned __int128 rest =
+            scaled & ((static_cast<unsigned __int128>(1) << shift) - 1);
+        digits = static_cast<uint64_t>(scaled >> shift);
+        if (rest > half || (rest == half && (digits & 1)))
+            digits++;
+    }
+
+    char text[32];
+    char *begin = text + sizeof text;
+    for (int i = 0; i < decimals; i++) {
+        *--begin = '0' + digits % 10;
+        digits /= 10;
+    }
+    *--begin = '.';
+    do {
+        *--begin = '0' + digits % 10;
+        digits /= 10;
+    } while (digits > 0);
+    if (std::signbit(value))
+        *--begin = '-';
+
+    int length = text + sizeof text - begin;
+    for (int i = length; i < width; i++)
+        *out++ = ' ';
+    memcpy(out, begin, length);
+    return out + length;
+}
+
+/** Writes x as libecl does in the GRDECL format; see scientific_format. */
+char *format_scientific(char *out, const scientific_format &format,
+                        double x) {
+    double pow_x = ceil(log10(fabs(x)));
+    double arg_x = x / power_of_ten(pow_x);
+    if (x != 0.0) {
+        if (fabs(arg_x) == 1.0) {
+            arg_x *= 0.10;
+            pow_x += 1;
+        }
+    } else {
+        arg_x = 0.0;
+        pow_x = 0.0;
+    }
+
+    char *end = nullptr;
+    if (std::isfinite(pow_x)) {
+        *out++ = ' ';
+        *out++ = ' ';
+        end = format_fixed(out, arg_x, format.width, format.decimals);
+        if (end == nullptr)
+            out -= 2;
+    }
+    if (end == nullptr)
+        return out + sprintf(out, format.printf_format, arg_x,
+                             static_cast<int>(pow_x));
+
+    int exponent = static_cast<int>(pow_x);
+    *end++ = format.exponent_char;
+    *end++ = exponent < 0 ? '-' : '+';
+    if (abs(exponent) < 10)
+        *end++ = '0';
+    return std::to_chars(end, end + 8, abs(exponent)).ptr;
+}
+
+/** Writes value as printf(" %11d"). */
+char *format_int(char *out, int value) {
+    char text[16];
+    char *end = std::to_chars(text, text + sizeof text, value).ptr;
+    int length = end - text;
+
+    *out++ = ' ';
+    for (int i = length; i < int_width; i++)
+        *out++ = ' ';
+    memcpy(out, text, length);
+    return out + length;
+}
+
+void fwrite_chunk(FILE *stream, const char *begin, const char *end) {
+    util_fwrite(begin, 1, end - begin, stream, __func__);
+}
+
+/** Writes value to out with the byte order of the ECLIPSE files. */
+char *put_int(char *out, int32_t value) {
+    if (ECL_ENDIAN_FLIP)
+        util_endian_flip_vector(&value, sizeof value, 1);
+    memcpy(out, &value, sizeof value);
+    return out + sizeof value;
+}
+
+} // namespace
+
+void ert::fwrite_grdecl(FILE *stream, const char *kw, ecl_data_type data_type,
+                        int size, const void *data) {
+    ecl_type_enum type = ecl_type_get_type(data_type);
+    int columns;
+    switch (type) {
+    case ECL_FLOAT_TYPE:
+        columns = float_format.columns;
+        break;
+    case ECL_DOUBLE_TYPE:
+        columns = double_format.columns;
+        break;
+    case ECL_INT_TYPE:
+        columns = int_columns;
+        break;
+    default:
+        util_abort("%s: can not write keyword:%s of type %d\n", __func__, kw,
+                   type);
+        return;
+    }
+
+    fprintf(stream, "%s\n", kw);
+
+    // Each element is at most 64 bytes, including the line break.
+    std::vector<char> text(chunk_size + 64);
+    char *out = text.data();
+    for (int block = 0; block < size; block += block_size) {
+        int block_end = std::min(block + block_size, size);
+        for (int i = block; i < block_end; i++) {
+            if (type == ECL_FLOAT_TYPE)
+                out = format_scientific(out, float_format,
+                                        static_cast<const float *>(data)[i]);
+            else if (type == ECL_DOUBLE_TYPE)
+                out = format_scientific(out, double_format,
+                                        static_cast<const double *>(data)[i]);
+            else
+                out = format_int(out, static_cast<const int *>(data)[i]);
+
+            if ((i - block + 1) % columns == 0 || i + 1 == block_end)
+                *out++ = '\n';
+            if (out - text.data() >= (long)chunk_size) {
+                fwrite_chunk(stream, text.data(), out);
+                out = text.data();
+            }
+        }
+    }
+    fwrite_chunk(stream, text.data(), out);
+    fprintf(stream, "/\n");
+}
+
+void ert::fwrite_ecl_kw(FILE *stream, const char *kw, ecl_data_type data_type,
+                        int size, const void *data) {
+    const char *type_name;
+    switch (ecl_type_get_type(data_type)) {
+    case ECL_FLOAT_TYPE:
+        type_name = "REAL";
+        break;
+    case ECL_DOUBLE_TYPE:
+        type_name = "DOUB";
+        break;
+    case ECL_INT_TYPE:
+        type_name = "INTE";
+        break;
+    default:
+        util_abort("%s: can not write keyword:%s of type %d\n", __func__, kw,
+                   ecl_type_get_type(data_type));
+        return;
+    }
+
+    // The header record with the name, size and type, followed by the data
+    // in records of block_size elements; each record is enclosed in its
+    // byte size.
+    const int element_size = ecl_type_get_sizeof_ctype(data_type);
+    const int num_blocks = (size + block_size - 1) / block_size;
+    std::vector<char> records(24 + (size_t)size * element_size +
+                              (size_t)num_blocks * 8);
+    char *out = put_int(records.data(), 16);
+    char header[9];
+    snprintf(header, sizeof header, "%-8s", kw);
+    memcpy(out, header, 8);
+    out = put_int(out + 8, size);
+    memcpy(out, type_name, 4);
+    out = put_int(out + 4, 16);
+
+    for (int block = 0; block < size; block += block_size) {
+        int block_elements = std::min(block_size, size - block);
+        int byte_size = block_elements * element_size;
+        out = put_int(out, byte_size);
+        memcpy(out, static_cast<const char *>(data) + block * element_size,
+               byte_size);
+        if (ECL_ENDIAN_FLIP)
+            util_endian_flip_vector(out, element_size, block_elements);
+        out = put_int(out + byte_size, byte_size);
+    }
+    util_fwrite(records.data(), 1, records.size(), stream, __func__);
+}
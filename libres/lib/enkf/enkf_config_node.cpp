@@ -16,6 +16,7 @@
    for more details.
 */
 
+#include <algorithm>
 #include <filesystem>
 
 #include <stdio.h>
@@ -122,6 +123,45 @@ bool enkf_config_node_has_vector(const enkf_config_node_type *node,
     return has_vector;
 }
 
+std::vector<bool>
+enkf_config_node_has_vectors(const enkf_config_node_type *node,
+                             enkf_fs_type *fs,
+                             const std::vector<int> &iens_list) {
+    return enkf_fs_has_vectors(fs, node->key, node->var_type, iens_list);
+}
+
+/**
+   Bulk version of enkf_config_node_has_node(); element i in the return value
+   tells whether the node has been stored for node_ids[i].
+*/
+std::vector<bool>
+enkf_config_node_has_nodes(const enkf_config_node_type *node, enkf_fs_type *fs,
+                           const std::vector<node_id_type> &node_ids) {
+    if (node->impl_type != CONTAINER)
+        return enkf_fs_has_nodes(fs, node->key, node->var_type, node_ids);
+
+    std::vector<bool> has_container(node_ids.size(), true);
+    std::vector<int> iens_list;
+    for (const auto &node_id : node_ids)
+        iens_list.push_back(node_id.iens);
+
+    for (int inode = 0; inode < vector_get_size(node->container_nodes);
+         inode++) {
+        const enkf_config_node_type *child_node =
+            (const enkf_config_node_type *)vector_iget_const(
+                node->container_nodes, inode);
+        std::vector<bool> has_child;
+        if (child_node->vector_storage)
+            has_child = enkf_config_node_has_vectors(child_node, fs, iens_list);
+        else
+            has_child = enkf_config_node_has_nodes(child_node, fs, node_ids);
+
+        for (size_t i = 0; i < node_ids.size(); i++)
+            has_container[i] = has_container[i] && has_child[i];
+    }
+    return has_container;
+}
+
 static enkf_config_node_type *enkf_config_node_alloc__(enkf_var_type var_type,
                                                        ert_impl_type impl_type,
                                                        const char *key,
@@ -587,6 +627,26 @@ bool enkf_config_node_internalize(const enkf_config_node_type *node,
             report_step); // Will return default value if report_step is beyond size.
 }
 
+/**
+   The report steps in [start, stop] at which the node should be
+   internalized, in increasing order.
+*/
+std::vector<int>
+enkf_config_node_get_internalize_steps(const enkf_config_node_type *node,
+                                       int start, int stop) {
+    std::vector<int> steps;
+    if (node->internalize == NULL)
+        return steps;
+
+    stop = std::min(stop, bool_vector_size(node->internalize) - 1);
+    for (int report_step = std::max(start, 0); report_step <= stop;
+         report_step++) {
+        if (bool_vector_iget(node->internalize, report_step))
+            steps.push_back(report_step);
+    }
+    return steps;
+}
+
 /**
    This is the filename used when loading from a completed forward
    model.
@@ -16,6 +16,7 @@
    for more details.
 */
 
+#include <atomic>
 #include <filesystem>
 #include <memory>
 #include <string>
@@ -33,6 +34,7 @@
 
 #include <ert/logging.hpp>
 #include <ert/res_util/file_utils.hpp>
+#include <ert/res_util/metric.hpp>
 #include <ert/res_util/path_fmt.hpp>
 #include <ert/res_util/string.hpp>
 
@@ -133,10 +135,18 @@ static auto logger = ert::get_logger("enkf");
 #define ENKF_FS_TYPE_ID 1089763
 #define ENKF_MOUNT_MAP "enkf_mount_info"
 #define SUMMARY_KEY_SET_FILE "summary-key-set"
+#define SUMMARY_COLUMNS_FILE "summary-columns"
+#define LOAD_REPORT_FILE "load-report.json"
 #define TIME_MAP_FILE "time-map"
 #define STATE_MAP_FILE "state-map"
 #define MISFIT_ENSEMBLE_FILE "misfit-ensemble"
 #define CASE_CONFIG_FILE "case_config"
+/** The node key of the summary table records in the dynamic_forecast
+ * driver. */
+#define SUMMARY_RECORD_KEY "__SUMMARY_TABLE__"
+/** The node key of the load sources of each realization in the
+ * dynamic_forecast driver. */
+#define LOAD_SOURCES_KEY "__LOAD_SOURCES__"
 
 struct enkf_fs_struct {
     UTIL_TYPE_ID_DECLARATION;
@@ -158,6 +168,9 @@ struct enkf_fs_struct {
     cases_config_type *cases_config;
     state_map_type *state_map;
     summary_key_set_type *summary_key_set;
+    /** The key dictionary of the summary table; empty unless the summary
+     * results of this case are stored as a table. */
+    std::unique_ptr<ert::summary_columns> summary_columns;
     /* The variables below here are for storing arbitrary files within the
      * enkf_fs storage directory, but not as serialized enkf_nodes. */
     misfit_ensemble_type *misfit_ensemble;
@@ -166,6 +179,13 @@ struct enkf_fs_struct {
     path_fmt_type *case_tstep_fmt;
     path_fmt_type *case_tstep_member_fmt;
 
+    /** Incremented on every write to the storage; used to invalidate cached
+     * responses. */
+    mutable std::atomic<long> generation{0};
+    std::unique_ptr<ert::measurement_cache> measurement_cache;
+    /** The profiles of the latest loading of each realization. */
+    std::unique_ptr<ert::load_report> load_report;
+
     int refcount;
     /** Counts the number of simulations currently writing to this enkf_fs; the
      * purpose is to be able to answer the question: Is this case currently 'running'? */
@@ -217,7 +237,11 @@ enkf_fs_type *enkf_fs_alloc_empty(const char *mount_point) {
     fs->cases_config = cases_config_alloc();
     fs->state_map = state_map_alloc();
     fs->summary_key_set = summary_key_set_alloc();
+    fs->summary_columns = std::make_unique<ert::summary_columns>();
     fs->misfit_ensemble = misfit_ensemble_alloc();
+    fs->measurement_cache = std::make_unique<ert::measurement_cache>(
+        DEFAULT_MEASUREMENT_CACHE_SIZE);
+    fs->load_report = std::make_unique<ert::load_report>();
     fs->read_only = true;
     fs->mount_point = util_alloc_string_copy(mount_point);
     fs->refcount = 0;
@@ -386,6 +410,15 @@ static void enkf_fs_fsync_summary_key_set(enkf_fs_type *fs) {
     free(filename);
 }
 
+static void enkf_fs_fsync_summary_columns(enkf_fs_type *fs) {
+    if (fs->summary_columns->size() == 0)
+        return;
+
+    char *filename = enkf_fs_alloc_case_filename(fs, SUMMARY_COLUMNS_FILE);
+    fs->summary_columns->fwrite(filename);
+    free(filename);
+}
+
 static void enkf_fs_fread_cases_config(enkf_fs_type *fs) {
     char *filename = enkf_fs_alloc_case_filename(fs, CASE_CONFIG_FILE);
     cases_config_fread(fs->cases_config, filename);
@@ -404,6 +437,12 @@ static void enkf_fs_fread_summary_key_set(enkf_fs_type *fs) {
     free(filename);
 }
 
+static void enkf_fs_fread_summary_columns(enkf_fs_type *fs) {
+    char *filename = enkf_fs_alloc_case_filename(fs, SUMMARY_COLUMNS_FILE);
+    fs->summary_columns->fread(filename);
+    free(filename);
+}
+
 state_map_type *enkf_fs_alloc_readonly_state_map(const char *mount_point) {
     path_fmt_type *path_fmt = path_fmt_alloc_directory_fmt(DEFAULT_CASE_PATH);
     char *filename =
@@ -424,13 +463,19 @@ static void enkf_fs_fread_misfit(enkf_fs_type *fs) {
     }
 }
 
+/**
+   The misfit ensemble is only written when the content differs from what is
+   already on disk.
+*/
 void enkf_fs_fwrite_misfit(enkf_fs_type *fs) {
-    if (misfit_ensemble_initialized(fs->misfit_ensemble)) {
+    if (misfit_ensemble_initialized(fs->misfit_ensemble) &&
+        misfit_ensemble_modified(fs->misfit_ensemble)) {
         char *filename = enkf_fs_alloc_case_filename(fs, MISFIT_ENSEMBLE_FILE);
         auto stream = mkdir_fopen(fs::path(filename), "w");
         free(filename);
         misfit_ensemble_fwrite(fs->misfit_ensemble, stream);
         fclose(stream);
+        misfit_ensemble_set_saved(fs->misfit_ensemble);
     }
 }
 
@@ -489,6 +534,7 @@ enkf_fs_type *enkf_fs_mount(const char *mount_point) {
     enkf_fs_fread_cases_config(fs);
     enkf_fs_fread_state_map(fs);
     enkf_fs_fread_summary_key_set(fs);
+    enkf_fs_fread_summary_columns(fs);
     enkf_fs_fread_misfit(fs);
 
     enkf_fs_get_ref(fs);
@@ -572,6 +618,8 @@ void enkf_fs_fsync(enkf_fs_type *fs) {
     enkf_fs_fsync_cases_config(fs);
     enkf_fs_fsync_state_map(fs);
     enkf_fs_fsync_summary_key_set(fs);
+    enkf_fs_fsync_summary_columns(fs);
+    enkf_fs_fwrite_load_report(fs);
 }
 
 void enkf_fs_fread_node(enkf_fs_type *enkf_fs, buffer_type *buffer,
@@ -589,9 +637,69 @@ void enkf_fs_fread_node(enkf_fs_type *enkf_fs, buffer_type *buffer,
     driver->load_node(node_key, report_step, iens, buffer);
 }
 
+/**
+   Bulk version of enkf_fs_fread_node(), for nodes of the same var_type;
+   node_keys[i] of node_ids[i] is read into buffers[i], and element i in
+   the return value tells whether it is stored. The nodes are read with one
+   pass over each block_fs instance.
+*/
+std::vector<bool>
+enkf_fs_fread_nodes(enkf_fs_type *enkf_fs,
+                    const std::vector<std::string> &node_keys,
+                    enkf_var_type var_type, std::vector<node_id_type> node_ids,
+                    const std::vector<buffer_type *> &buffers) {
+    if (node_keys.empty())
+        return {};
+
+    ert::block_fs_driver *driver =
+        enkf_fs_select_driver(enkf_fs, var_type, node_keys[0].c_str());
+    if (var_type == PARAMETER)
+        /* Parameters are *ONLY* stored at report_step == 0 */
+        for (auto &node_id : node_ids)
+            node_id.report_step = 0;
+
+    return driver->load_nodes(node_keys, node_ids, buffers);
+}
+
+/**
+   Reads the column of the summary vector node_key from the summary table
+   record of realization iens; returns false if the vector is not stored in
+   the summary table. With values == nullptr only the existence is checked.
+*/
+static bool enkf_fs_fread_summary_column(enkf_fs_type *fs,
+                                         const char *node_key,
+                                         enkf_var_type var_type, int iens,
+                                         std::vector<float> *values) {
+    if (var_type != DYNAMIC_RESULT)
+        return false;
+
+    int column = fs->summary_columns->get(node_key);
+    if (column < 0 ||
+        !fs->dynamic_forecast->has_vector(SUMMARY_RECORD_KEY, iens))
+        return false;
+
+    auto read_range = [fs, iens](size_t offset, void *ptr, size_t byte_size) {
+        fs->dynamic_forecast->load_vector_range(SUMMARY_RECORD_KEY, iens,
+                                                offset, ptr, byte_size);
+    };
+    return ert::summary_record::fread_column(read_range, column, values);
+}
+
+/**
+   Summary vectors which are stored in the summary table are read from there,
+   and presented in the same layout as when they are stored as vectors.
+*/
 void enkf_fs_fread_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
                           const char *node_key, enkf_var_type var_type,
                           int iens) {
+    std::vector<float> values;
+    if (enkf_fs_fread_summary_column(enkf_fs, node_key, var_type, iens,
+                                     &values)) {
+        buffer_clear(buffer);
+        ert::summary_record_fwrite_vector(buffer, values);
+        buffer_rewind(buffer);
+        return;
+    }
 
     ert::block_fs_driver *driver =
         (ert::block_fs_driver *)enkf_fs_select_driver(enkf_fs, var_type,
@@ -610,11 +718,43 @@ bool enkf_fs_has_node(enkf_fs_type *enkf_fs, const char *node_key,
 
 bool enkf_fs_has_vector(enkf_fs_type *enkf_fs, const char *node_key,
                         enkf_var_type var_type, int iens) {
+    if (enkf_fs_fread_summary_column(enkf_fs, node_key, var_type, iens,
+                                     nullptr))
+        return true;
+
     ert::block_fs_driver *driver =
         enkf_fs_select_driver(enkf_fs, var_type, node_key);
     return driver->has_vector(node_key, iens);
 }
 
+/**
+   Bulk versions of enkf_fs_has_vector() and enkf_fs_has_node(); the
+   underlying storage is queried with one lookup pass per block_fs
+   instance, instead of once per element.
+*/
+std::vector<bool> enkf_fs_has_vectors(enkf_fs_type *enkf_fs,
+                                      const char *node_key,
+                                      enkf_var_type var_type,
+                                      const std::vector<int> &iens_list) {
+    ert::block_fs_driver *driver =
+        enkf_fs_select_driver(enkf_fs, var_type, node_key);
+    std::vector<bool> has_vector = driver->has_vectors(node_key, iens_list);
+    for (size_t i = 0; i < iens_list.size(); i++) {
+        if (!has_vector[i])
+            has_vector[i] = enkf_fs_fread_summary_column(
+                enkf_fs, node_key, var_type, iens_list[i], nullptr);
+    }
+    return has_vector;
+}
+
+std::vector<bool> enkf_fs_has_nodes(enkf_fs_type *enkf_fs, const char *node_key,
+                                    enkf_var_type var_type,
+                                    const std::vector<node_id_type> &node_ids) {
+    ert::block_fs_driver *driver =
+        enkf_fs_select_driver(enkf_fs, var_type, node_key);
+    return driver->has_nodes(node_key, node_ids);
+}
+
 void enkf_fs_fwrite_node(enkf_fs_type *enkf_fs, buffer_type *buffer,
                          const char *node_key, enkf_var_type var_type,
                          int report_step, int iens) {
@@ -627,9 +767,12 @@ void enkf_fs_fwrite_node(enkf_fs_type *enkf_fs, buffer_type *buffer,
         util_abort(
             "%s: Parameters can only be saved for report_step = 0   %s:%d\n",
             __func__, node_key, report_step);
+    ert::utils::ScopedTimer timer("enkf_fs.write");
+    ert::utils::Profile::count_bytes("enkf_fs.write", buffer_get_size(buffer));
     ert::block_fs_driver *driver =
         enkf_fs_select_driver(enkf_fs, var_type, node_key);
     driver->save_node(node_key, report_step, iens, buffer);
+    enkf_fs->generation++;
 }
 
 void enkf_fs_fwrite_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
@@ -639,9 +782,12 @@ void enkf_fs_fwrite_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
         util_abort("%s: attempt to write to read_only filesystem mounted at:%s "
                    "- aborting. \n",
                    __func__, enkf_fs->mount_point);
+    ert::utils::ScopedTimer timer("enkf_fs.write");
+    ert::utils::Profile::count_bytes("enkf_fs.write", buffer_get_size(buffer));
     ert::block_fs_driver *driver =
         enkf_fs_select_driver(enkf_fs, var_type, node_key);
     driver->save_vector(node_key, iens, buffer);
+    enkf_fs->generation++;
 }
 
 const char *enkf_fs_get_mount_point(const enkf_fs_type *fs) {
@@ -687,6 +833,8 @@ FILE *enkf_fs_open_case_tstep_file(const enkf_fs_type *fs,
     char *filename = enkf_fs_alloc_case_tstep_filename(fs, tstep, input_name);
     auto stream = mkdir_fopen(fs::path(filename), mode);
     free(filename);
+    if (mode[0] != 'r')
+        fs->generation++;
     return stream;
 }
 
@@ -728,6 +876,106 @@ summary_key_set_type *enkf_fs_get_summary_key_set(const enkf_fs_type *fs) {
     return fs->summary_key_set;
 }
 
+/**
+   The generation counts the writes to this filesystem; results derived
+   from the stored data are up to date as long as the generation is
+   unchanged. Observe that writes from other processes are not counted.
+*/
+long enkf_fs_get_generation(const enkf_fs_type *fs) { return fs->generation; }
+
+ert::measurement_cache &enkf_fs_get_measurement_cache(const enkf_fs_type *fs) {
+    return *fs->measurement_cache;
+}
+
+/**
+   The summary results of a case are stored as a table, with one record per
+   realization, once a key has been added to the summary columns of the case.
+   Summary vectors which are not in the table are still read from their
+   separate vector nodes.
+*/
+bool enkf_fs_has_summary_table(const enkf_fs_type *fs) {
+    return fs->summary_columns->size() > 0;
+}
+
+ert::summary_columns &enkf_fs_get_summary_columns(const enkf_fs_type *fs) {
+    return *fs->summary_columns;
+}
+
+/**
+   Loads the summary table record of realization iens into record; returns
+   false, leaving record unchanged, if it has not been stored.
+*/
+bool enkf_fs_fread_summary_record(enkf_fs_type *fs, int iens,
+                                  ert::summary_record &record) {
+    if (!fs->dynamic_forecast->has_vector(SUMMARY_RECORD_KEY, iens))
+        return false;
+
+    buffer_type *buffer = buffer_alloc(100);
+    fs->dynamic_forecast->load_vector(SUMMARY_RECORD_KEY, iens, buffer);
+    record.fread(buffer);
+    buffer_free(buffer);
+    return true;
+}
+
+void enkf_fs_fwrite_summary_record(enkf_fs_type *fs, int iens,
+                                   const ert::summary_record &record) {
+    buffer_type *buffer = buffer_alloc(100);
+    record.fwrite(buffer);
+    enkf_fs_fwrite_vector(fs, buffer, SUMMARY_RECORD_KEY, DYNAMIC_RESULT,
+                          iens);
+    buffer_free(buffer);
+}
+
+/**
+   Loads the fingerprints of the files the results of realization iens were
+   loaded from; returns false, leaving sources unchanged, if they have not
+   been stored.
+*/
+bool enkf_fs_fread_load_sources(enkf_fs_type *fs, int iens,
+                                ert::load_sources &sources) {
+    if (!fs->dynamic_forecast->has_vector(LOAD_SOURCES_KEY, iens))
+        return false;
+
+    buffer_type *buffer = buffer_alloc(100);
+    fs->dynamic_forecast->load_vector(LOAD_SOURCES_KEY, iens, buffer);
+    sources.fread(buffer);
+    buffer_free(buffer);
+    return true;
+}
+
+void enkf_fs_fwrite_load_sources(enkf_fs_type *fs, int iens,
+                                 const ert::load_sources &sources) {
+    buffer_type *buffer = buffer_alloc(100);
+    sources.fwrite(buffer);
+    enkf_fs_fwrite_vector(fs, buffer, LOAD_SOURCES_KEY, DYNAMIC_RESULT, iens);
+    buffer_free(buffer);
+}
+
+/**
+   Records the profile of the loading of the results of realization iens in
+   the load report of the case. The report is written once per batch of
+   loaded realizations, by enkf_fs_fwrite_load_report().
+*/
+void enkf_fs_add_load_profile(enkf_fs_type *fs, int iens,
+                              fw_load_status status,
+                              const ert::utils::Profile &profile) {
+    fs->load_report->add(iens, status, profile);
+}
+
+/**
+   Writes the load report of the case, if any realizations have been loaded
+   since the case was mounted. This is called when a batch of realizations
+   has been loaded, and by enkf_fs_fsync().
+*/
+void enkf_fs_fwrite_load_report(enkf_fs_type *fs) {
+    if (fs->load_report->size() == 0)
+        return;
+
+    char *filename = enkf_fs_alloc_case_filename(fs, LOAD_REPORT_FILE);
+    fs->load_report->fwrite(filename);
+    free(filename);
+}
+
 misfit_ensemble_type *enkf_fs_get_misfit_ensemble(const enkf_fs_type *fs) {
     return fs->misfit_ensemble;
 }
@@ -19,7 +19,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <filesystem>
 #include <future>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -27,6 +30,7 @@
 
 #include <ert/python.hpp>
 #include <ert/res_util/path_fmt.hpp>
+#include <ert/res_util/runpath_manifest.hpp>
 #include <ert/util/bool_vector.h>
 #include <ert/util/hash.h>
 #include <ert/util/int_vector.h>
@@ -56,6 +60,8 @@
 
 #include <ert/python.hpp>
 
+namespace fs = std::filesystem;
+
 static auto logger = ert::get_logger("enkf");
 
 #define ENKF_MAIN_ID 8301
@@ -376,33 +382,37 @@ ert_workflow_list_type *enkf_main_get_workflow_list(enkf_main_type *enkf_main) {
 int enkf_main_load_from_forward_model_with_fs(enkf_main_type *enkf_main,
                                               int iter,
                                               bool_vector_type *iactive,
-                                              enkf_fs_type *fs) {
+                                              enkf_fs_type *fs,
+                                              bool force_reload) {
     model_config_type *model_config = enkf_main_get_model_config(enkf_main);
     ert_run_context_type *run_context =
         ert_run_context_alloc_ENSEMBLE_EXPERIMENT(
             fs, iactive, model_config_get_runpath_fmt(model_config),
             model_config_get_jobname_fmt(model_config),
             enkf_main_get_data_kw(enkf_main), iter);
-    int loaded = enkf_main_load_from_run_context(enkf_main, run_context, fs);
+    int loaded = enkf_main_load_from_run_context(enkf_main, run_context, fs,
+                                                 force_reload);
     ert_run_context_free(run_context);
     return loaded;
 }
 
+/**
+   Loads the results of the active realizations of run_context into its
+   case, and returns the number of realizations which were loaded. Results
+   which are unchanged since they were last loaded into the case are not
+   loaded again, unless force_reload is set.
+*/
 int enkf_main_load_from_run_context(enkf_main_type *enkf_main,
                                     ert_run_context_type *run_context,
-                                    enkf_fs_type *fs) {
+                                    enkf_fs_type *fs, bool force_reload) {
     auto const ens_size = enkf_main_get_ensemble_size(enkf_main);
     auto const *iactive = ert_run_context_get_iactive(run_context);
 
-    // Loading state from a fwd-model is mainly io-bound so we can
-    // allow a lot more than #cores threads to execute in parallel.
-    // The number 100 is quite arbitrarily chosen though and should
-    // probably come from some resource like a site-config or similar.
-    // NOTE that this mechanism only limits the number of *concurrently
-    // executing* threads. The number of instantiated and stored futures
-    // will be equal to the number of active realizations.
-    Semafoor concurrently_executing_threads(100);
-    std::vector<std::tuple<int, std::future<fw_load_status>>> futures;
+    std::vector<int> realizations;
+    for (int iens = 0; iens < ens_size; ++iens) {
+        if (bool_vector_iget(iactive, iens))
+            realizations.push_back(iens);
+    }
 
     // If this function is called via pybind11 we need to release
     // the GIL here because this function may spin up several
@@ -411,38 +421,32 @@ int enkf_main_load_from_run_context(enkf_main_type *enkf_main,
     if (PyGILState_Check() == 1)
         state = PyEval_SaveThread();
 
-    for (int iens = 0; iens < ens_size; ++iens) {
-        if (bool_vector_iget(iactive, iens)) {
-
-            futures.push_back(std::make_tuple(
-                iens, // for logging later
-                std::async(
-                    std::launch::async,
-                    [=](const int realisation, Semafoor &execution_limiter) {
-                        // Acquire permit from semaphore or pause execution
-                        // until one becomes available. A successfully acquired
-                        // permit is released when exiting scope.
-                        std::scoped_lock lock(execution_limiter);
-
-                        auto *state_map = enkf_fs_get_state_map(
-                            run_arg_get_sim_fs(ert_run_context_iget_arg(
-                                run_context, realisation)));
-
-                        state_map_update_undefined(state_map, realisation,
-                                                   STATE_INITIALIZED);
-                        try {
-                            return enkf_state_load_from_forward_model(
-                                enkf_main_iget_state(enkf_main, realisation),
-                                ert_run_context_iget_arg(run_context,
-                                                         realisation));
-                        } catch (const std::invalid_argument) {
-                            state_map_iset(state_map, realisation,
-                                           STATE_LOAD_FAILURE);
-                            return LOAD_FAILURE;
-                        }
-                    },
-                    iens, std::ref(concurrently_executing_threads))));
-        }
+    // Loading state from a fwd-model is mainly io-bound, so the pool has a
+    // few threads per core. The realizations are submitted in order, so
+    // that consecutive tasks mostly write to different block_fs shards.
+    const size_t max_load_threads = 100;
+    ert::worker_pool pool(ert::worker_pool::io_bound_size(
+        std::min(max_load_threads, realizations.size())));
+    std::vector<std::tuple<int, std::future<fw_load_status>>> futures;
+
+    for (int iens : realizations) {
+        futures.push_back(std::make_tuple(
+            iens, // for logging later
+            pool.submit([=]() {
+                auto *state_map = enkf_fs_get_state_map(run_arg_get_sim_fs(
+                    ert_run_context_iget_arg(run_context, iens)));
+
+                state_map_update_undefined(state_map, iens, STATE_INITIALIZED);
+                try {
+                    return enkf_state_load_from_forward_model(
+                        enkf_main_iget_state(enkf_main, iens),
+                        ert_run_context_iget_arg(run_context, iens),
+                        force_reload);
+                } catch (const std::invalid_argument) {
+                    state_map_iset(state_map, iens, STATE_LOAD_FAILURE);
+                    return LOAD_FAILURE;
+                }
+            })));
     }
 
     int loaded = 0;
@@ -456,6 +460,7 @@ int enkf_main_load_from_run_context(enkf_main_type *enkf_main,
         } else
             logger->error("Unknown load enum");
     }
+    enkf_fs_fwrite_load_report(ert_run_context_get_sim_fs(run_context));
     if (state)
         PyEval_RestoreThread(state);
 
@@ -572,12 +577,13 @@ std::vector<std::string> get_parameter_keys(py::object self) {
 }
 
 int load_from_forward_model_with_fs_pybind(py::object self, int iter,
-                                           py::object iactive, py::object fs) {
+                                           py::object iactive, py::object fs,
+                                           bool force_reload) {
     auto enkf_main = ert::from_cwrap<enkf_main_type>(self);
     auto iactive_ = ert::from_cwrap<bool_vector_type>(iactive);
     auto fs_ = ert::from_cwrap<enkf_fs_type>(fs);
     return enkf_main_load_from_forward_model_with_fs(enkf_main, iter, iactive_,
-                                                     fs_);
+                                                     fs_, force_reload);
 }
 
 namespace enkf_main {
@@ -586,11 +592,14 @@ namespace enkf_main {
  *  Substitutes the parameters of the templated ECL_DATA_FILE
  *  and writes it to the runpath.
  *
- * @param data_file_template The template for the data file.
+ * @param data_file The filter of the template for the data file, which is
+ *      shared by the runs.
  * @param run_arg Contains the information about the given run.
+ * @param manifest The manifest of the runpath, or NULL.
  */
-void write_eclipse_data_file(const char *data_file_template,
-                             const run_arg_type *run_arg) {
+void write_eclipse_data_file(const ert::subst_file_filter &data_file,
+                             const run_arg_type *run_arg,
+                             ert::runpath_manifest *manifest) {
     char *data_file_destination = ecl_util_alloc_filename(
         run_arg_get_runpath(run_arg), run_arg_get_job_name(run_arg),
         ECL_DATA_FILE, true, -1);
@@ -600,8 +609,7 @@ void write_eclipse_data_file(const char *data_file_template,
     subst_list_update_string(subst_list, &data_file_destination);
 
     //Perform substitutions on the data file template contents
-    subst_list_filter_file(subst_list, data_file_template,
-                           data_file_destination);
+    data_file.filter(subst_list, data_file_destination, manifest);
 
     free(data_file_destination);
 }
@@ -620,35 +628,104 @@ void write_eclipse_data_file(const char *data_file_template,
     "parameters", value export file will e.g. be "parameters.json")
   @param run_arg The run_arg containing the run_path to write the target file in.
   @param fs The enkf_fs to load sampled parameters from
+  @param manifest The manifest of the runpath which the value_export files
+    are written through, or NULL.
+
+  The order of the exported values is computed by the first realization and
+  kept in ens_config for the following realizations.
 */
 void ecl_write(const ensemble_config_type *ens_config,
                const char *export_base_name, const run_arg_type *run_arg,
-               enkf_fs_type *fs) {
+               enkf_fs_type *fs, ert::runpath_manifest *manifest = NULL) {
     value_export_type *export_value =
         value_export_alloc(run_arg_get_runpath(run_arg), export_base_name);
+    auto export_layout = ensemble_config_get_export_layout(ens_config);
+    value_export_set_layout(export_value, export_layout);
+    value_export_set_manifest(export_value, manifest);
+
+    node_id_type node_id = {.report_step = run_arg_get_step1(run_arg),
+                            .iens = run_arg_get_iens(run_arg)};
+    auto write_nodes = [&](const std::vector<enkf_node_type *> &nodes) {
+        std::vector<bool> loaded = enkf_node_load_nodes(nodes, fs, node_id);
+        for (size_t i = 0; i < nodes.size(); i++) {
+            enkf_node_type *enkf_node = nodes[i];
+            if (loaded[i])
+                enkf_node_ecl_write(enkf_node, run_arg_get_runpath(run_arg),
+                                    export_value, run_arg_get_step1(run_arg));
+            else if (run_arg_get_step1(run_arg) != 0 ||
+                     !enkf_node_use_forward_init(enkf_node))
+                util_abort("%s: could not load node:%s iens:%d\n", __func__,
+                           enkf_node_get_key(enkf_node), node_id.iens);
+            enkf_node_free(enkf_node);
+        }
+    };
 
+    // The parameters are loaded together, except the fields which are large
+    // and loaded one at a time.
+    std::vector<enkf_node_type *> nodes;
+    std::vector<enkf_node_type *> fields;
     for (auto &key : ensemble_config_keylist_from_var_type(
              ens_config, PARAMETER + EXT_PARAMETER)) {
         enkf_node_type *enkf_node =
             enkf_node_alloc(ensemble_config_get_node(ens_config, key.c_str()));
-        node_id_type node_id = {.report_step = run_arg_get_step1(run_arg),
-                                .iens = run_arg_get_iens(run_arg)};
-
-        if (run_arg_get_step1(run_arg) == 0 &&
-            enkf_node_use_forward_init(enkf_node) &&
-            !enkf_node_has_data(enkf_node, fs, node_id))
-            continue;
-        enkf_node_load(enkf_node, fs, node_id);
-
-        enkf_node_ecl_write(enkf_node, run_arg_get_runpath(run_arg),
-                            export_value, run_arg_get_step1(run_arg));
-        enkf_node_free(enkf_node);
+        if (enkf_node_get_impl_type(enkf_node) == FIELD)
+            fields.push_back(enkf_node);
+        else
+            nodes.push_back(enkf_node);
     }
+    write_nodes(nodes);
+    for (enkf_node_type *field : fields)
+        write_nodes({field});
     value_export(export_value);
 
+    auto layout = value_export_get_layout(export_value);
+    if (layout != export_layout)
+        ensemble_config_set_export_layout(ens_config, layout);
     value_export_free(export_value);
 }
 
+/**
+ * @brief Initializes one active run; see init_active_runs().
+ *
+ * @param jobs_json The jobs.json content of the run, which is filled with the
+ *      run arguments of run_arg.
+ * @param data_file The filter of the eclipse data file template, or NULL if
+ *      no data file is written.
+ *
+ * The generated files are written through the runpath_manifest of the
+ * runpath, so the files whose content is unchanged since the runpath was
+ * last initialized are not written again.
+ */
+void init_active_run(const res_config_type *res_config,
+                     const run_arg_type *run_arg,
+                     const ert::jobs_json &jobs_json,
+                     const ert::subst_file_filter *data_file) {
+    // Unlike util_make_path(), this does not fail when another realization
+    // creates a common parent directory at the same time.
+    fs::create_directories(run_arg_get_runpath(run_arg));
+    ert::runpath_manifest manifest(run_arg_get_runpath(run_arg));
+
+    model_config_type *model_config = res_config_get_model_config(res_config);
+    ensemble_config_type *ens_config =
+        res_config_get_ensemble_config(res_config);
+
+    ert_templates_instansiate(res_config_get_templates(res_config),
+                              run_arg_get_runpath(run_arg),
+                              run_arg_get_subst_list(run_arg), &manifest);
+
+    ecl_write(ens_config, model_config_get_gen_kw_export_name(model_config),
+              run_arg, run_arg_get_sim_fs(run_arg), &manifest);
+
+    // Create the eclipse data file (if eclbase and DATA_FILE)
+    if (data_file)
+        write_eclipse_data_file(*data_file, run_arg, &manifest);
+
+    // Create the job script
+    forward_model_json_fwrite(jobs_json, run_arg_get_runpath(run_arg),
+                              run_arg_get_subst_list(run_arg), &manifest);
+    manifest.save();
+}
+
 /**
  * @brief Initializes all active runs.
  *
@@ -659,50 +736,86 @@ void ecl_write(const ensemble_config_type *ens_config,
  *  * substitutes DATAKW into the eclipse data file template and write it to runpath;
  *  * write the job script.
  *
+ * The job script is compiled once for the run context, and only the strings
+ * with run arguments are filled per realization. Likewise the eclipse data
+ * file template is read once, see ert::subst_file_filter.
+ *
+ * The runs are initialized concurrently. The runs which fail are logged, and
+ * reported together in a std::runtime_error when all the runs are done.
+ *
  * @param res_config The config to use for initialization.
  * @param run_context Contains all the runs.
  */
 void init_active_runs(const res_config_type *res_config,
                       const ert_run_context_type *run_context) {
+    std::vector<int> realizations;
     for (int iens = 0; iens < ert_run_context_get_size(run_context); iens++) {
-        if (ert_run_context_iactive(run_context, iens)) {
-            run_arg_type *run_arg = ert_run_context_iget_arg(run_context, iens);
-            util_make_path(run_arg_get_runpath(run_arg));
-
-            model_config_type *model_config =
-                res_config_get_model_config(res_config);
-            ensemble_config_type *ens_config =
-                res_config_get_ensemble_config(res_config);
-
-            ert_templates_instansiate(res_config_get_templates(res_config),
-                                      run_arg_get_runpath(run_arg),
-                                      run_arg_get_subst_list(run_arg));
-
-            ecl_write(ens_config,
-                      model_config_get_gen_kw_export_name(model_config),
-                      run_arg, run_arg_get_sim_fs(run_arg));
-
-            // Create the eclipse data file (if eclbase and DATA_FILE)
-            const ecl_config_type *ecl_config =
-                res_config_get_ecl_config(res_config);
-            const char *data_file_template =
-                ecl_config_get_data_file(ecl_config);
-            if (ecl_config_have_eclbase(ecl_config) && data_file_template) {
-                write_eclipse_data_file(data_file_template, run_arg);
-            }
+        if (ert_run_context_iactive(run_context, iens))
+            realizations.push_back(iens);
+    }
+
+    const model_config_type *model_config =
+        res_config_get_model_config(res_config);
+    const site_config_type *site_config =
+        res_config_get_site_config(res_config);
+    const ert::jobs_json jobs_json = forward_model_compile_json(
+        model_config_get_forward_model(model_config),
+        ert_run_context_get_id(run_context),
+        model_config_get_data_root(model_config),
+        site_config_get_umask(site_config),
+        site_config_get_env_varlist(site_config));
+
+    // The eclipse data file template is mapped once, and filtered for each
+    // run.
+    std::unique_ptr<ert::subst_file_filter> data_file;
+    const ecl_config_type *ecl_config = res_config_get_ecl_config(res_config);
+    const char *data_file_template = ecl_config_get_data_file(ecl_config);
+    if (ecl_config_have_eclbase(ecl_config) && data_file_template)
+        data_file =
+            std::make_unique<ert::subst_file_filter>(data_file_template);
 
-            // Create the job script
-            const site_config_type *site_config =
-                res_config_get_site_config(res_config);
-            forward_model_formatted_fprintf(
-                model_config_get_forward_model(model_config),
-                run_arg_get_run_id(run_arg), run_arg_get_runpath(run_arg),
-                model_config_get_data_root(model_config),
-                run_arg_get_subst_list(run_arg),
-                site_config_get_umask(site_config),
-                site_config_get_env_varlist(site_config));
+    // If this function is called via pybind11 we need to release
+    // the GIL here because the worker threads may need the GIL
+    // (e.g. for logging)
+    PyThreadState *state = nullptr;
+    if (PyGILState_Check() == 1)
+        state = PyEval_SaveThread();
+
+    // Creating the runpaths is mainly io-bound. Each task holds the
+    // parameters of one realization in memory, which limits the number
+    // of threads more than for loading.
+    const size_t max_runpath_threads = 32;
+    std::vector<int> failed;
+    {
+        ert::worker_pool pool(ert::worker_pool::io_bound_size(
+            std::min(max_runpath_threads, realizations.size())));
+        std::vector<std::tuple<int, std::future<void>>> futures;
+        for (int iens : realizations) {
+            futures.push_back(std::make_tuple(iens, pool.submit([&, iens]() {
+                init_active_run(res_config,
+                                ert_run_context_iget_arg(run_context, iens),
+                                jobs_json, data_file.get());
+            })));
+        }
+
+        for (auto &[iens, fut] : futures) {
+            try {
+                fut.get();
+            } catch (const std::exception &e) {
+                logger->error("Failed to create the runpath of realization "
+                              "{}: {}",
+                              iens, e.what());
+                failed.push_back(iens);
+            }
         }
     }
+    if (state)
+        PyEval_RestoreThread(state);
+
+    if (!failed.empty())
+        throw std::runtime_error(
+            fmt::format("Failed to create the runpath of realization(s): {}",
+                        fmt::join(failed, ", ")));
 }
 
 /**
@@ -748,7 +861,8 @@ RES_LIB_SUBMODULE("enkf_main", m) {
         },
         py::arg("self"), py::arg("run_context"));
     m.def("load_from_forward_model", load_from_forward_model_with_fs_pybind,
-          py::arg("self"), py::arg("iter"), py::arg("iactive"), py::arg("fs"));
+          py::arg("self"), py::arg("iter"), py::arg("iactive"), py::arg("fs"),
+          py::arg("force_reload") = false);
 }
 
 #include "enkf_main_ensemble.cpp"
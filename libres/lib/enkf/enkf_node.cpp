@@ -16,6 +16,10 @@
    for more details.
 */
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -515,6 +519,74 @@ void enkf_node_load(enkf_node_type *enkf_node, enkf_fs_type *fs,
     }
 }
 
+/**
+   Loads several nodes of the same realization and report step, where the
+   nodes without vector storage are read from fs with one bulk read per
+   var_type instead of one read per node. Element i in the return value
+   tells whether nodes[i] was loaded; for the parameters the existence is
+   checked at report step 0, where they are stored.
+*/
+std::vector<bool>
+enkf_node_load_nodes(const std::vector<enkf_node_type *> &nodes,
+                     enkf_fs_type *fs, node_id_type node_id) {
+    struct leaf_node {
+        enkf_node_type *node;
+        size_t index;
+    };
+    std::vector<bool> loaded(nodes.size(), true);
+    std::map<enkf_var_type, std::vector<leaf_node>> leaf_nodes;
+
+    auto add_node = [&](auto &add_node, enkf_node_type *node,
+                        size_t index) -> void {
+        if (enkf_node_get_impl_type(node) == CONTAINER) {
+            for (int inode = 0; inode < vector_get_size(node->container_nodes);
+                 inode++)
+                add_node(add_node,
+                         (enkf_node_type *)vector_iget(node->container_nodes,
+                                                       inode),
+                         index);
+        } else if (node->vector_storage) {
+            if (!enkf_node_try_load(node, fs, node_id))
+                loaded[index] = false;
+        } else {
+            if (node->read_from_buffer == NULL)
+                util_abort("%s: function handler: read_from_buffer not "
+                           "registered for node:%s - aborting\n",
+                           __func__, node->node_key);
+            enkf_var_type var_type =
+                enkf_config_node_get_var_type(enkf_node_get_config(node));
+            leaf_nodes[var_type].push_back({node, index});
+        }
+    };
+    for (size_t i = 0; i < nodes.size(); i++)
+        add_node(add_node, nodes[i], i);
+
+    for (const auto &[var_type, leaves] : leaf_nodes) {
+        std::vector<std::string> node_keys;
+        std::vector<buffer_type *> buffers;
+        for (const auto &leaf : leaves) {
+            node_keys.push_back(
+                enkf_config_node_get_key(enkf_node_get_config(leaf.node)));
+            buffers.push_back(buffer_alloc(100));
+        }
+
+        std::vector<bool> has_node = enkf_fs_fread_nodes(
+            fs, node_keys, var_type,
+            std::vector<node_id_type>(leaves.size(), node_id), buffers);
+        for (size_t i = 0; i < leaves.size(); i++) {
+            enkf_node_type *node = leaves[i].node;
+            if (has_node[i]) {
+                buffer_fskip_time_t(buffers[i]);
+                node->read_from_buffer(node->data, buffers[i], fs,
+                                       node_id.report_step);
+            } else
+                loaded[leaves[i].index] = false;
+            buffer_free(buffers[i]);
+        }
+    }
+    return loaded;
+}
+
 bool enkf_node_try_load_vector(enkf_node_type *enkf_node, enkf_fs_type *fs,
                                int iens) {
     if (enkf_config_node_has_vector(enkf_node->config, fs, iens)) {
@@ -601,6 +673,17 @@ bool enkf_node_has_data(enkf_node_type *enkf_node, enkf_fs_type *fs,
         return enkf_config_node_has_node(enkf_node->config, fs, node_id);
 }
 
+/**
+   Check whether a node with vector storage, where the vector has already been
+   loaded with enkf_node_load_vector(), has data for report_step. As opposed to
+   enkf_node_has_data() this will not go to storage.
+*/
+bool enkf_node_vector_has_data(const enkf_node_type *enkf_node,
+                               int report_step) {
+    FUNC_ASSERT(enkf_node->has_data);
+    return enkf_node->has_data(enkf_node->data, report_step);
+}
+
 void enkf_node_serialize(enkf_node_type *enkf_node, enkf_fs_type *fs,
                          node_id_type node_id, const ActiveList *active_list,
                          Eigen::MatrixXd &A, int row_offset, int column) {
@@ -298,10 +298,25 @@ int enkf_obs_get_size(const enkf_obs_type *obs) {
     return vector_get_size(obs->obs_vector);
 }
 
+static std::shared_ptr<const meas_block_type>
+enkf_obs_alloc_shared_block_copy(const meas_data_type *meas_data) {
+    int num_blocks = meas_data_get_num_blocks(meas_data);
+    return std::shared_ptr<const meas_block_type>(
+        meas_block_alloc_copy(
+            meas_data_iget_block_const(meas_data, num_blocks - 1)),
+        meas_block_free);
+}
+
+/**
+   The measured responses are added to @measured, unless @cached is non
+   NULL; then the responses are taken from there instead of being loaded
+   from storage.
+*/
 static void enkf_obs_get_obs_and_measure_summary(
     const enkf_obs_type *enkf_obs, obs_vector_type *obs_vector,
     enkf_fs_type *fs, const std::vector<int> &ens_active_list,
-    meas_data_type *meas_data, obs_data_type *obs_data) {
+    meas_data_type *meas_data, obs_data_type *obs_data,
+    const ert::measurement *cached, ert::measurement &measured) {
 
     int active_count = 0;
     int last_step = -1;
@@ -331,6 +346,19 @@ static void enkf_obs_get_obs_and_measure_summary(
     time-aggregated summary observation.
   */
 
+    if (cached) {
+        obs_block_type *obs_block = obs_data_add_block(
+            obs_data, obs_vector_get_obs_key(obs_vector), active_count);
+        for (int i = 0; i < active_count; i++)
+            obs_block_iset(obs_block, i, observations[i].first,
+                           observations[i].second);
+        for (const auto &[iobs, msg] : cached->deactivated)
+            obs_block_deactivate(obs_block, iobs, msg.c_str());
+        for (const auto &[report_step, meas_block] : cached->blocks)
+            meas_data_add_block_copy(meas_data, report_step, meas_block.get());
+        return;
+    }
+
     {
         obs_block_type *obs_block = obs_data_add_block(
             obs_data, obs_vector_get_obs_key(obs_vector), active_count);
@@ -369,6 +397,7 @@ static void enkf_obs_get_obs_and_measure_summary(
                         step, smlength);
                     meas_block_deactivate(meas_block, active_count);
                     obs_block_deactivate(obs_block, active_count, msg);
+                    measured.deactivated.emplace_back(active_count, msg);
                     free(msg);
                     break;
                 } else {
@@ -382,6 +411,8 @@ static void enkf_obs_get_obs_and_measure_summary(
             active_count++;
         }
         enkf_node_free(work_node);
+        measured.blocks.emplace_back(
+            last_step, enkf_obs_alloc_shared_block_copy(meas_data));
     }
 }
 
@@ -394,33 +425,64 @@ static void enkf_obs_get_obs_and_measure_node(
         (obs_vector_type *)hash_get(enkf_obs->obs_hash, obs_key.c_str());
     obs_impl_type obs_type = obs_vector_get_impl_type(obs_vector);
 
-    if (obs_type == SUMMARY_OBS) {
+    ert::measurement_cache &cache = enkf_fs_get_measurement_cache(fs);
+    long obs_version = obs_vector_get_version(obs_vector);
+    long generation = enkf_fs_get_generation(fs);
+    auto cached = cache.get(obs_key, obs_version, generation, ens_active_list);
+    auto measured = std::make_shared<ert::measurement>();
 
-        enkf_obs_get_obs_and_measure_summary(
-            enkf_obs, obs_vector, fs, ens_active_list, meas_data, obs_data);
-
-        return;
-    }
+    if (obs_type == SUMMARY_OBS) {
+        enkf_obs_get_obs_and_measure_summary(enkf_obs, obs_vector, fs,
+                                             ens_active_list, meas_data,
+                                             obs_data, cached.get(), *measured);
+    } else {
+        // obs_type is GEN_OBS or BLOCK_OBS
+        size_t cached_block = 0;
+        int report_step = -1;
+        while (true) {
+            report_step =
+                obs_vector_get_next_active_step(obs_vector, report_step);
+            if (report_step < 0)
+                break;
 
-    // obs_type is GEN_OBS or BLOCK_OBS
-    int report_step = -1;
-    while (true) {
-        report_step = obs_vector_get_next_active_step(obs_vector, report_step);
-        if (report_step < 0)
-            return;
-
-        if (obs_vector_iget_active(obs_vector, report_step)) {
-            /* Collect the observed data in the obs_data instance. */
-            obs_vector_iget_observations(obs_vector, report_step, obs_data, fs);
-            obs_vector_measure(obs_vector, fs, report_step, ens_active_list,
-                               meas_data);
+            if (obs_vector_iget_active(obs_vector, report_step)) {
+                /* Collect the observed data in the obs_data instance. */
+                obs_vector_iget_observations(obs_vector, report_step, obs_data,
+                                             fs);
+                if (cached) {
+                    const auto &blocks = cached->blocks;
+                    if (cached_block < blocks.size() &&
+                        blocks[cached_block].first == report_step) {
+                        meas_data_add_block_copy(
+                            meas_data, report_step,
+                            blocks[cached_block].second.get());
+                        cached_block++;
+                    }
+                } else {
+                    int num_blocks = meas_data_get_num_blocks(meas_data);
+                    obs_vector_measure(obs_vector, fs, report_step,
+                                       ens_active_list, meas_data);
+                    if (meas_data_get_num_blocks(meas_data) > num_blocks)
+                        measured->blocks.emplace_back(
+                            report_step,
+                            enkf_obs_alloc_shared_block_copy(meas_data));
+                }
+            }
         }
     }
+
+    if (!cached && enkf_fs_get_generation(fs) == generation)
+        cache.put(obs_key, obs_version, generation, ens_active_list,
+                  std::move(measured));
 }
 
 /**
   This will append observations and simulated responses from
   report_step to obs_data and meas_data.
+
+  The simulated responses are cached in the enkf_fs instance, so repeated
+  calls for the same observations and realizations on an unchanged case do
+  not load the responses from storage again.
 */
 void enkf_obs_get_obs_and_measure_data(
     const enkf_obs_type *enkf_obs, enkf_fs_type *fs,
@@ -16,6 +16,8 @@
    for more details.
 */
 
+#include <algorithm>
+#include <optional>
 #include <stdexcept>
 #include <stdio.h>
 #include <string.h>
@@ -24,12 +26,14 @@
 #include <vector>
 
 #include <ert/python.hpp>
+#include <ert/res_util/metric.hpp>
 #include <ert/res_util/subst_list.hpp>
 #include <ert/util/hash.h>
 #include <ert/util/rng.h>
 
 #include <ert/ecl/ecl_kw.h>
 #include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_util.h>
 
 #include <ert/job_queue/environment_varlist.hpp>
 #include <ert/job_queue/forward_model.hpp>
@@ -38,10 +42,14 @@
 #include <ert/enkf/enkf_node.hpp>
 #include <ert/enkf/enkf_state.hpp>
 #include <ert/enkf/gen_data.hpp>
+#include <ert/enkf/load_sources.hpp>
 #include <ert/logging.hpp>
+#include <fmt/format.h>
 
 static auto logger = ert::get_logger("enkf");
 #define ENKF_STATE_TYPE_ID 78132
+/** The key of the summary results in the load sources of a realization. */
+#define SUMMARY_SOURCE_KEY "__SUMMARY__"
 
 /**
    This struct contains various objects which the enkf_state needs
@@ -238,10 +246,91 @@ static void enkf_state_check_for_missing_eclipse_summary_data(
     stringlist_free(keys);
 }
 
+/**
+   Loads each of the matched summary vectors, and stores it as a separate
+   vector.
+*/
+static void enkf_state_internalize_summary_vectors(
+    ensemble_config_type *ens_config, forward_load_context_type *load_context,
+    enkf_fs_type *sim_fs, const std::vector<std::string> &smspec_keys,
+    const std::vector<bool> &matched, const int_vector_type *time_index,
+    int iens) {
+
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < smspec_keys.size(); i++)
+        if (matched[i])
+            keys.push_back(smspec_keys[i]);
+    auto config_nodes =
+        ensemble_config_get_or_create_summary_nodes(ens_config, keys);
+
+    summary_key_set_type *key_set = enkf_fs_get_summary_key_set(sim_fs);
+    for (size_t i = 0; i < keys.size(); i++) {
+        summary_key_set_add_summary_key(key_set, keys[i].c_str());
+
+        enkf_node_type *node = enkf_node_alloc(config_nodes[i]);
+
+        // Ensure that what is currently on file is loaded
+        // before we update.
+        enkf_node_try_load_vector(node, sim_fs, iens);
+
+        enkf_node_forward_load_vector(node, load_context, time_index);
+        enkf_node_store_vector(node, sim_fs, iens);
+        enkf_node_free(node);
+    }
+}
+
+/**
+   Loads the matched summary vectors into the summary table record of the
+   realization. The values which are already
+   stored for the realization are kept for the steps before load_start, as
+   when the vectors are stored one by one.
+*/
+static void enkf_state_internalize_summary_table(
+    ensemble_config_type *ens_config, enkf_fs_type *sim_fs,
+    const ecl_sum_type *summary, const std::vector<std::string> &smspec_keys,
+    const std::vector<bool> &matched, const int_vector_type *time_index,
+    int iens) {
+
+    summary_key_set_type *key_set = enkf_fs_get_summary_key_set(sim_fs);
+    ert::summary_columns &columns = enkf_fs_get_summary_columns(sim_fs);
+    const int num_steps = int_vector_size(time_index);
+
+    ert::summary_record record;
+    enkf_fs_fread_summary_record(sim_fs, iens, record);
+
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < smspec_keys.size(); i++)
+        if (matched[i])
+            keys.push_back(smspec_keys[i]);
+    ensemble_config_get_or_create_summary_nodes(ens_config, keys);
+
+    for (const auto &summary_key : keys) {
+        const char *key = summary_key.c_str();
+        summary_key_set_add_summary_key(key_set, key);
+
+        int column = columns.add(key);
+        record.resize(columns.size(), num_steps);
+
+        float *values = record.column(column);
+        int key_index = ecl_sum_get_general_var_params_index(summary, key);
+        for (int step = 0; step < num_steps; step++) {
+            int summary_step = int_vector_iget(time_index, step);
+            if (summary_step >= 0 &&
+                ecl_sum_has_report_step(summary, summary_step)) {
+                int ministep = ecl_sum_iget_report_end(summary, summary_step);
+                values[step] = ecl_sum_iget(summary, ministep, key_index);
+            }
+        }
+    }
+
+    enkf_fs_fwrite_summary_record(sim_fs, iens, record);
+}
+
 static bool enkf_state_internalize_dynamic_eclipse_results(
     ensemble_config_type *ens_config, forward_load_context_type *load_context,
     const model_config_type *model_config) {
 
+    ert::utils::ScopedTimer timer("summary.internalize");
     bool load_summary = ensemble_config_has_impl_type(ens_config, SUMMARY);
     const run_arg_type *run_arg =
         forward_load_context_get_run_arg(load_context);
@@ -288,32 +377,40 @@ static bool enkf_state_internalize_dynamic_eclipse_results(
 
                 const ecl_smspec_type *smspec = ecl_sum_get_smspec(summary);
 
+                // All the realizations normally have the same SMSPEC keys, so
+                // the matching is looked up in the matcher after the first.
+                std::vector<std::string> smspec_keys;
+                smspec_keys.reserve(ecl_smspec_num_nodes(smspec));
                 for (int i = 0; i < ecl_smspec_num_nodes(smspec); i++) {
-                    const ecl::smspec_node &smspec_node =
-                        ecl_smspec_iget_node_w_node_index(smspec, i);
-                    const char *key = smspec_node.get_gen_key1();
-
-                    if (summary_key_matcher_match_summary_key(matcher, key)) {
-                        summary_key_set_type *key_set =
-                            enkf_fs_get_summary_key_set(sim_fs);
-                        summary_key_set_add_summary_key(key_set, key);
-
-                        enkf_config_node_type *config_node =
-                            ensemble_config_get_or_create_summary_node(
-                                ens_config, key);
-                        enkf_node_type *node = enkf_node_alloc(config_node);
-
-                        // Ensure that what is currently on file is loaded
-                        // before we update.
-                        enkf_node_try_load_vector(node, sim_fs, iens);
-
-                        enkf_node_forward_load_vector(node, load_context,
-                                                      time_index);
-                        enkf_node_store_vector(node, sim_fs, iens);
-                        enkf_node_free(node);
-                    }
+                    const char *key =
+                        ecl_smspec_iget_node_w_node_index(smspec, i)
+                            .get_gen_key1();
+                    // Nodes without a key are kept as "", which is never
+                    // matched, so that the keys line up with the nodes.
+                    smspec_keys.push_back(key ? key : "");
+                }
+                std::shared_ptr<const std::vector<bool>> matched;
+                {
+                    ert::utils::ScopedTimer match_timer("summary.match");
+                    matched = summary_key_matcher_match_summary_keys(
+                        matcher, smspec_keys);
                 }
 
+                // Once a case has a summary table it is used for all the
+                // realizations, also when the configuration does not ask for
+                // it, so that no vectors are hidden behind the table.
+                const bool summary_table =
+                    ensemble_config_use_summary_table(ens_config) ||
+                    enkf_fs_has_summary_table(sim_fs);
+                if (summary_table)
+                    enkf_state_internalize_summary_table(
+                        ens_config, sim_fs, summary, smspec_keys, *matched,
+                        time_index, iens);
+                else
+                    enkf_state_internalize_summary_vectors(
+                        ens_config, load_context, sim_fs, smspec_keys,
+                        *matched, time_index, iens);
+
                 int_vector_free(time_index);
 
                 // Check if some of the specified keys are missing from the Eclipse
@@ -335,12 +432,57 @@ static bool enkf_state_internalize_dynamic_eclipse_results(
     }
 }
 
+/**
+   The result file of a GEN_DATA node at report_step and its _active file,
+   or nullopt if the node has no result file. Whether the _active file exists
+   is returned in has_active_file.
+*/
+static std::optional<ert::result_files>
+enkf_state_gen_data_files(const forward_load_context_type *load_context,
+                          const enkf_config_node_type *config_node,
+                          int report_step, bool &has_active_file) {
+    ert::utils::ScopedTimer timer("fingerprint");
+    has_active_file = false;
+    char *input_file = enkf_config_node_alloc_infile(config_node, report_step);
+    if (!input_file)
+        return std::nullopt;
+
+    char *file = util_alloc_filename(
+        forward_load_context_get_run_path(load_context), input_file, NULL);
+    const std::string active_file = std::string(file) + "_active";
+    has_active_file =
+        forward_load_context_file_exists(load_context, active_file.c_str());
+    ert::result_files files({file, active_file}, input_file);
+    free(file);
+    free(input_file);
+    return files;
+}
+
 static void enkf_state_load_gen_data_node(
     forward_load_context_type *load_context, enkf_fs_type *sim_fs, int iens,
-    const enkf_config_node_type *config_node, int start, int stop) {
-    for (int report_step = start; report_step <= stop; report_step++) {
-        if (!enkf_config_node_internalize(config_node, report_step))
+    const enkf_config_node_type *config_node, int start, int stop,
+    ert::load_sources &sources) {
+    const char *key = enkf_config_node_get_key(config_node);
+    for (int report_step :
+         enkf_config_node_get_internalize_steps(config_node, start, stop)) {
+        const std::string source_key =
+            std::string(key) + ":" + std::to_string(report_step);
+        bool has_active_file;
+        auto files = enkf_state_gen_data_files(load_context, config_node,
+                                               report_step, has_active_file);
+        // The active mask of the node is shared by the ensemble and built
+        // from the _active files of all the loaded realizations, hence a
+        // node with an _active file must be loaded to keep the mask whole.
+        if (!has_active_file && files &&
+            sources.unchanged(source_key, *files) &&
+            enkf_fs_has_node(sim_fs, key,
+                             enkf_config_node_get_var_type(config_node),
+                             report_step, iens)) {
+            logger->info("[{:03d}:{:04d}] GEN_DATA: {} is unchanged - not "
+                         "loaded again.",
+                         iens, report_step, key);
             continue;
+        }
 
         forward_load_context_select_step(load_context, report_step);
         enkf_node_type *node = enkf_node_alloc(config_node);
@@ -349,6 +491,8 @@ static void enkf_state_load_gen_data_node(
             node_id_type node_id = {.report_step = report_step, .iens = iens};
 
             enkf_node_store(node, sim_fs, node_id);
+            if (files)
+                sources.set(source_key, *files);
             logger->info("Loaded GEN_DATA: {} instance for step: {} from file: "
                          "{} size: {}",
                          enkf_node_get_key(node), report_step,
@@ -357,6 +501,7 @@ static void enkf_state_load_gen_data_node(
                          gen_data_get_size(
                              (const gen_data_type *)enkf_node_value_ptr(node)));
         } else {
+            sources.erase(source_key);
             forward_load_context_update_result(load_context, LOAD_FAILURE);
             logger->error(
                 "[{:03d}:{:04d}] Failed load data for GEN_DATA node:{}.", iens,
@@ -370,8 +515,9 @@ static void
 enkf_state_internalize_GEN_DATA(const ensemble_config_type *ens_config,
                                 forward_load_context_type *load_context,
                                 const model_config_type *model_config,
-                                int last_report) {
+                                int last_report, ert::load_sources &sources) {
 
+    ert::utils::ScopedTimer timer("gen_data.internalize");
     stringlist_type *keylist_GEN_DATA =
         ensemble_config_alloc_keylist_from_impl_type(ens_config, GEN_DATA);
 
@@ -393,21 +539,88 @@ enkf_state_internalize_GEN_DATA(const ensemble_config_type *ens_config,
         const enkf_config_node_type *config_node = ensemble_config_get_node(
             ens_config, stringlist_iget(keylist_GEN_DATA, ikey));
 
-        // This for loop should probably be changed to use the report
-        // steps configured in the gen_data_config object, instead of
-        // spinning through them all.
         int start = run_arg_get_load_start(run_arg);
         int stop = util_int_max(0, last_report); // inclusive
         enkf_state_load_gen_data_node(load_context, sim_fs, iens, config_node,
-                                      start, stop);
+                                      start, stop, sources);
     }
     stringlist_free(keylist_GEN_DATA);
 }
 
+/**
+   The summary files of run_arg, with the summary configuration as context,
+   or nullopt if there are no summary files.
+*/
+static std::optional<ert::result_files>
+enkf_state_summary_files(const ensemble_config_type *ens_config,
+                         const ecl_config_type *ecl_config,
+                         const run_arg_type *run_arg) {
+    if (!ecl_config || !ecl_config_active(ecl_config))
+        return std::nullopt;
+
+    ert::utils::ScopedTimer timer("fingerprint");
+    const char *run_path = run_arg_get_runpath(run_arg);
+    const char *eclbase = run_arg_get_job_name(run_arg);
+    const bool fmt_file = ecl_config_get_formatted(ecl_config);
+    char *header_file = ecl_util_alloc_exfilename(
+        run_path, eclbase, ECL_SUMMARY_HEADER_FILE, fmt_file, -1);
+    char *unified_file = ecl_util_alloc_exfilename(
+        run_path, eclbase, ECL_UNIFIED_SUMMARY_FILE, fmt_file, -1);
+
+    std::optional<ert::result_files> files;
+    if (header_file && unified_file) {
+        stringlist_type *key_list = summary_key_matcher_get_keys(
+            ensemble_config_get_summary_key_matcher(ens_config));
+        std::vector<std::string> keys;
+        for (int i = 0; i < stringlist_get_size(key_list); i++)
+            keys.push_back(stringlist_iget(key_list, i));
+        stringlist_free(key_list);
+        std::sort(keys.begin(), keys.end());
+
+        std::string context =
+            std::to_string(run_arg_get_load_start(run_arg)) + ":" +
+            std::to_string(ecl_config_get_end_date(ecl_config)) + ":" +
+            std::to_string(ensemble_config_use_summary_table(ens_config));
+        for (const auto &key : keys)
+            context += ":" + key;
+
+        files.emplace(std::vector<std::string>{header_file, unified_file},
+                      context);
+    }
+    free(header_file);
+    free(unified_file);
+    return files;
+}
+
+/**
+   Checks that all the summary vectors of the case are stored for realization
+   iens, so that its summary results need not be loaded again, and if so
+   ensures that they are in the ensemble configuration, as when they are
+   loaded.
+*/
+static bool enkf_state_reuse_summary_results(ensemble_config_type *ens_config,
+                                             enkf_fs_type *sim_fs, int iens) {
+    stringlist_type *keys =
+        summary_key_set_alloc_keys(enkf_fs_get_summary_key_set(sim_fs));
+    bool stored = stringlist_get_size(keys) > 0;
+    for (int i = 0; stored && i < stringlist_get_size(keys); i++)
+        stored = enkf_fs_has_vector(sim_fs, stringlist_iget(keys, i),
+                                    DYNAMIC_RESULT, iens);
+
+    if (stored) {
+        std::vector<std::string> summary_keys;
+        for (int i = 0; i < stringlist_get_size(keys); i++)
+            summary_keys.push_back(stringlist_iget(keys, i));
+        ensemble_config_get_or_create_summary_nodes(ens_config, summary_keys);
+    }
+    stringlist_free(keys);
+    return stored;
+}
+
 static forward_load_context_type *
 enkf_state_alloc_load_context(const ensemble_config_type *ens_config,
                               const ecl_config_type *ecl_config,
-                              const run_arg_type *run_arg) {
+                              const run_arg_type *run_arg, bool skip_summary) {
     bool load_summary = false;
     const summary_key_matcher_type *matcher =
         ensemble_config_get_summary_key_matcher(ens_config);
@@ -417,10 +630,13 @@ enkf_state_alloc_load_context(const ensemble_config_type *ens_config,
     if (ensemble_config_require_summary(ens_config))
         load_summary = true;
 
+    if (skip_summary)
+        load_summary = false;
+
     forward_load_context_type *load_context;
 
-    load_context =
-        forward_load_context_alloc(run_arg, load_summary, ecl_config);
+    load_context = forward_load_context_alloc_matching(run_arg, load_summary,
+                                                       ecl_config, matcher);
     return load_context;
 }
 
@@ -431,68 +647,118 @@ enkf_state_alloc_load_context(const ensemble_config_type *ens_config,
 
    Will mainly be called at the end of the forward model, but can also
    be called manually from external scope.
+
+   The results whose files have the same fingerprint as when they were
+   loaded into the case, and which are still stored, are not loaded again,
+   unless force_reload is set.
 */
 static fw_load_status enkf_state_internalize_results(
     ensemble_config_type *ens_config, model_config_type *model_config,
-    const ecl_config_type *ecl_config, const run_arg_type *run_arg) {
+    const ecl_config_type *ecl_config, const run_arg_type *run_arg,
+    bool force_reload) {
 
-    forward_load_context_type *load_context =
-        enkf_state_alloc_load_context(ens_config, ecl_config, run_arg);
+    enkf_fs_type *sim_fs = run_arg_get_sim_fs(run_arg);
+    const int iens = run_arg_get_iens(run_arg);
+    ert::load_sources sources;
+    if (!force_reload)
+        enkf_fs_fread_load_sources(sim_fs, iens, sources);
+
+    auto summary_files =
+        enkf_state_summary_files(ens_config, ecl_config, run_arg);
+    const bool summary_unchanged =
+        summary_files &&
+        sources.unchanged(SUMMARY_SOURCE_KEY, *summary_files) &&
+        enkf_state_reuse_summary_results(ens_config, sim_fs, iens);
+
+    forward_load_context_type *load_context = enkf_state_alloc_load_context(
+        ens_config, ecl_config, run_arg, summary_unchanged);
 
     // The timing information - i.e. mainly what is the last report step
     // in these results are inferred from the loading of summary results,
-    // hence we must load the summary results first.
-    try {
-        enkf_state_internalize_dynamic_eclipse_results(ens_config, load_context,
-                                                       model_config);
-    } catch (const std::invalid_argument) {
-        forward_load_context_free(load_context);
-        throw;
+    // hence we must load the summary results first. When they are unchanged
+    // the time map of the case already has it.
+    if (summary_unchanged) {
+        logger->info("[{:03d}:----] Summary results are unchanged - not "
+                     "loaded again.",
+                     iens);
+    } else {
+        try {
+            enkf_state_internalize_dynamic_eclipse_results(
+                ens_config, load_context, model_config);
+        } catch (const std::invalid_argument) {
+            forward_load_context_free(load_context);
+            throw;
+        }
+
+        if (summary_files &&
+            forward_load_context_get_ecl_sum(load_context) &&
+            forward_load_context_get_result(load_context) == LOAD_SUCCESSFUL)
+            sources.set(SUMMARY_SOURCE_KEY, *summary_files);
+        else
+            sources.erase(SUMMARY_SOURCE_KEY);
     }
 
-    enkf_fs_type *sim_fs = run_arg_get_sim_fs(run_arg);
     int last_report = time_map_get_last_step(enkf_fs_get_time_map(sim_fs));
     if (last_report < 0)
         last_report = model_config_get_last_history_restart(model_config);
 
     enkf_state_internalize_GEN_DATA(ens_config, load_context, model_config,
-                                    last_report);
+                                    last_report, sources);
+    enkf_fs_fwrite_load_sources(sim_fs, iens, sources);
 
     auto result = forward_load_context_get_result(load_context);
     forward_load_context_free(load_context);
     return result;
 }
 
+/**
+   The time, calls and bytes of the phases of the loading are recorded, and
+   added to the load report of the case; see load_report.hpp.
+*/
 static fw_load_status enkf_state_load_from_forward_model__(
     ensemble_config_type *ens_config, model_config_type *model_config,
-    const ecl_config_type *ecl_config, const run_arg_type *run_arg) {
+    const ecl_config_type *ecl_config, const run_arg_type *run_arg,
+    bool force_reload) {
+    enkf_fs_type *sim_fs = run_arg_get_sim_fs(run_arg);
+    int iens = run_arg_get_iens(run_arg);
+    ert::utils::Profile profile;
     auto result = LOAD_SUCCESSFUL;
-    if (ensemble_config_have_forward_init(ens_config))
-        result = ensemble_config_forward_init(ens_config, run_arg);
-    if (result == LOAD_SUCCESSFUL) {
-        result = enkf_state_internalize_results(ens_config, model_config,
-                                                ecl_config, run_arg);
+    {
+        ert::utils::ProfileScope profile_scope(profile);
+        ert::utils::ScopedTimer timer("load");
+        if (ensemble_config_have_forward_init(ens_config)) {
+            ert::utils::ScopedTimer forward_init_timer("forward_init");
+            result = ensemble_config_forward_init(ens_config, run_arg);
+        }
+        if (result == LOAD_SUCCESSFUL) {
+            result = enkf_state_internalize_results(
+                ens_config, model_config, ecl_config, run_arg, force_reload);
+        }
     }
-    state_map_type *state_map =
-        enkf_fs_get_state_map(run_arg_get_sim_fs(run_arg));
-    int iens = run_arg_get_iens(run_arg);
+    state_map_type *state_map = enkf_fs_get_state_map(sim_fs);
     if (result == LOAD_FAILURE)
         state_map_iset(state_map, iens, STATE_LOAD_FAILURE);
     else
         state_map_iset(state_map, iens, STATE_HAS_DATA);
 
+    enkf_fs_add_load_profile(sim_fs, iens, result, profile);
     return result;
 }
 
+/**
+   Loads the results of run_arg; with force_reload the results are loaded
+   even if they are unchanged since they were last loaded into the case.
+*/
 fw_load_status enkf_state_load_from_forward_model(enkf_state_type *enkf_state,
-                                                  run_arg_type *run_arg) {
+                                                  run_arg_type *run_arg,
+                                                  bool force_reload) {
 
     ensemble_config_type *ens_config = enkf_state->ensemble_config;
     model_config_type *model_config = enkf_state->shared_info->model_config;
     const ecl_config_type *ecl_config = enkf_state->shared_info->ecl_config;
 
-    return enkf_state_load_from_forward_model__(ens_config, model_config,
-                                                ecl_config, run_arg);
+    return enkf_state_load_from_forward_model__(
+        ens_config, model_config, ecl_config, run_arg, force_reload);
 }
 
 void enkf_state_free(enkf_state_type *enkf_state) {
@@ -538,8 +804,8 @@ bool enkf_state_complete_forward_modelOK(const res_config_type *res_config,
                  "load results.",
                  iens, run_arg_get_step1(run_arg), run_arg_get_step2(run_arg));
 
-    auto result = enkf_state_load_from_forward_model__(ens_config, model_config,
-                                                       ecl_config, run_arg);
+    auto result = enkf_state_load_from_forward_model__(
+        ens_config, model_config, ecl_config, run_arg, false);
 
     if (result == LOAD_SUCCESSFUL) {
         // The loading succeded - so this is a howling success! We set
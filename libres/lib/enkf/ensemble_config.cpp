@@ -18,11 +18,12 @@
 
 #include <filesystem>
 #include <map>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
-#include <pthread.h> /* must have rw locking on the config_nodes ... */
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -88,7 +89,9 @@ get_string(const std::unordered_map<std::string, std::string> &opt_map,
 
 struct ensemble_config_struct {
     UTIL_TYPE_ID_DECLARATION;
-    pthread_mutex_t mutex;
+    /** Guards config_nodes, which summary nodes are added to while the
+     * realizations are loaded concurrently. */
+    mutable std::shared_mutex mutex;
     char *
         gen_kw_format_string; /* format string used when creating gen_kw search/replace strings. */
     std::map<std::string, enkf_config_node_type *>
@@ -97,6 +100,13 @@ struct ensemble_config_struct {
         field_trans_table; /* a table of the transformations which are available to apply on fields. */
     bool have_forward_init;
     summary_key_matcher_type *summary_key_matcher;
+    /** Store the summary results as one table per realization instead of one
+     * vector per key; see summary_table.hpp. */
+    bool summary_table;
+    /** The layout of the exported parameter values of the last realization
+     * which was written; see value_export_layout. */
+    mutable std::mutex export_layout_mutex;
+    mutable std::shared_ptr<const value_export_layout> export_layout;
 };
 
 UTIL_IS_INSTANCE_FUNCTION(ensemble_config, ENSEMBLE_CONFIG_TYPE_ID)
@@ -166,7 +176,7 @@ static ensemble_config_type *ensemble_config_alloc_empty(void) {
         util_alloc_string_copy(DEFAULT_GEN_KW_TAG_FORMAT);
     ensemble_config->have_forward_init = false;
     ensemble_config->summary_key_matcher = summary_key_matcher_alloc();
-    pthread_mutex_init(&ensemble_config->mutex, NULL);
+    ensemble_config->summary_table = false;
 
     return ensemble_config;
 }
@@ -177,7 +187,6 @@ ensemble_config_alloc_full(const char *gen_kw_format_string) {
     ensemble_config->field_trans_table = field_trans_table_alloc();
     ensemble_config_set_gen_kw_format(ensemble_config, gen_kw_format_string);
     ensemble_config->summary_key_matcher = summary_key_matcher_alloc();
-    pthread_mutex_init(&ensemble_config->mutex, NULL);
     return ensemble_config;
 }
 
@@ -228,30 +237,100 @@ void ensemble_config_free(ensemble_config_type *ensemble_config) {
     delete ensemble_config;
 }
 
+/**
+   Returns the node of key, or NULL; the caller must hold the lock.
+*/
+static enkf_config_node_type *
+ensemble_config_find_node__(const ensemble_config_type *ensemble_config,
+                            const std::string &key) {
+    const auto node_it = ensemble_config->config_nodes.find(key);
+    if (node_it != ensemble_config->config_nodes.end())
+        return node_it->second;
+    return NULL;
+}
+
+/**
+   Adds node to config_nodes; the caller must hold the lock exclusively.
+*/
+static void ensemble_config_add_node__(ensemble_config_type *ensemble_config,
+                                       enkf_config_node_type *node) {
+    if (node) {
+        const char *key = enkf_config_node_get_key(node);
+        if (ensemble_config->config_nodes.count(key) > 0)
+            util_abort("%s: a configuration object:%s has already been added - "
+                       "aborting \n",
+                       __func__, key);
+
+        ensemble_config->config_nodes[key] = node;
+        ensemble_config->have_forward_init |=
+            enkf_config_node_use_forward_init(node);
+    } else
+        util_abort("%s: internal error - tried to add NULL node to ensemble "
+                   "configuration \n",
+                   __func__);
+}
+
 bool ensemble_config_has_key(const ensemble_config_type *ensemble_config,
                              const char *key) {
+    std::shared_lock<std::shared_mutex> lock(ensemble_config->mutex);
     return ensemble_config->config_nodes.count(key) > 0;
 }
 
 enkf_config_node_type *
 ensemble_config_get_node(const ensemble_config_type *ensemble_config,
                          const char *key) {
-    const auto node_it = ensemble_config->config_nodes.find(key);
-    if (node_it != ensemble_config->config_nodes.end()) {
-        enkf_config_node_type *node = node_it->second;
-        return node;
-    } else {
-        util_abort("%s: ens node:\"%s\" does not exist \n", __func__, key);
-        return NULL; /* compiler shut up */
+    enkf_config_node_type *node;
+    {
+        std::shared_lock<std::shared_mutex> lock(ensemble_config->mutex);
+        node = ensemble_config_find_node__(ensemble_config, key);
     }
+    if (!node)
+        util_abort("%s: ens node:\"%s\" does not exist \n", __func__, key);
+    return node;
 }
 
 enkf_config_node_type *ensemble_config_get_or_create_summary_node(
     ensemble_config_type *ensemble_config, const char *key) {
-    if (ensemble_config->config_nodes.count(key) == 0)
-        ensemble_config_add_summary(ensemble_config, key, LOAD_FAIL_SILENT);
+    return ensemble_config_get_or_create_summary_nodes(ensemble_config,
+                                                       {key})[0];
+}
 
-    return ensemble_config_get_node(ensemble_config, key);
+/**
+   Looks up the summary nodes of keys, and adds the ones which do not exist.
+   The lookups share the lock with the other loading threads, and the lock
+   is only taken exclusively when a realization has keys which have not been
+   seen before.
+*/
+std::vector<enkf_config_node_type *>
+ensemble_config_get_or_create_summary_nodes(
+    ensemble_config_type *ensemble_config,
+    const std::vector<std::string> &keys) {
+    std::vector<enkf_config_node_type *> nodes(keys.size());
+    bool missing = false;
+    {
+        std::shared_lock<std::shared_mutex> lock(ensemble_config->mutex);
+        for (size_t i = 0; i < keys.size(); i++) {
+            nodes[i] = ensemble_config_find_node__(ensemble_config, keys[i]);
+            missing |= (nodes[i] == NULL);
+        }
+    }
+
+    if (missing) {
+        std::unique_lock<std::shared_mutex> lock(ensemble_config->mutex);
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (nodes[i])
+                continue;
+
+            // Another thread may have added it in the meantime
+            nodes[i] = ensemble_config_find_node__(ensemble_config, keys[i]);
+            if (!nodes[i]) {
+                nodes[i] = enkf_config_node_alloc_summary(keys[i].c_str(),
+                                                          LOAD_FAIL_SILENT);
+                ensemble_config_add_node__(ensemble_config, nodes[i]);
+            }
+        }
+    }
+    return nodes;
 }
 
 bool ensemble_config_have_forward_init(
@@ -261,20 +340,8 @@ bool ensemble_config_have_forward_init(
 
 void ensemble_config_add_node(ensemble_config_type *ensemble_config,
                               enkf_config_node_type *node) {
-    if (node) {
-        const char *key = enkf_config_node_get_key(node);
-        if (ensemble_config_has_key(ensemble_config, key))
-            util_abort("%s: a configuration object:%s has already been added - "
-                       "aborting \n",
-                       __func__, key);
-
-        ensemble_config->config_nodes[key] = node;
-        ensemble_config->have_forward_init |=
-            enkf_config_node_use_forward_init(node);
-    } else
-        util_abort("%s: internal error - tried to add NULL node to ensemble "
-                   "configuration \n",
-                   __func__);
+    std::unique_lock<std::shared_mutex> lock(ensemble_config->mutex);
+    ensemble_config_add_node__(ensemble_config, node);
 }
 
 void ensemble_config_add_obs_key(ensemble_config_type *ensemble_config,
@@ -290,6 +357,35 @@ void ensemble_config_clear_obs_keys(ensemble_config_type *ensemble_config) {
     }
 }
 
+void ensemble_config_set_summary_table(ensemble_config_type *ensemble_config,
+                                       bool summary_table) {
+    ensemble_config->summary_table = summary_table;
+}
+
+bool ensemble_config_use_summary_table(
+    const ensemble_config_type *ensemble_config) {
+    return ensemble_config->summary_table;
+}
+
+std::shared_ptr<const value_export_layout>
+ensemble_config_get_export_layout(const ensemble_config_type *ensemble_config) {
+    std::lock_guard<std::mutex> lock(ensemble_config->export_layout_mutex);
+    return ensemble_config->export_layout;
+}
+
+/**
+   Records the layout of the exported values, for the following
+   realizations to reuse. The layout is only replaced when the keys of a
+   realization differ, so the realizations which are written concurrently
+   normally share one layout.
+*/
+void ensemble_config_set_export_layout(
+    const ensemble_config_type *ensemble_config,
+    std::shared_ptr<const value_export_layout> layout) {
+    std::lock_guard<std::mutex> lock(ensemble_config->export_layout_mutex);
+    ensemble_config->export_layout = std::move(layout);
+}
+
 void ensemble_config_add_config_items(config_parser_type *config) {
     config_schema_item_type *item;
 
@@ -313,6 +409,7 @@ void ensemble_config_add_config_items(config_parser_type *config) {
 
     item = config_add_key_value(config, GEN_KW_TAG_FORMAT_KEY, false,
                                 CONFIG_STRING);
+    item = config_add_key_value(config, SUMMARY_TABLE_KEY, false, CONFIG_BOOL);
     item = config_add_schema_item(config, SCHEDULE_PREDICTION_FILE_KEY, false);
     /* scedhule_prediction_file   filename  <parameters:> <init_files:> */
     config_schema_item_set_argc_minmax(item, 1, 3);
@@ -678,6 +775,11 @@ static void ensemble_config_init(ensemble_config_type *ensemble_config,
             config_content_iget(config, GEN_KW_TAG_FORMAT_KEY, 0, 0));
     }
 
+    if (config_content_has_item(config, SUMMARY_TABLE_KEY))
+        ensemble_config_set_summary_table(
+            ensemble_config,
+            config_content_get_value_as_bool(config, SUMMARY_TABLE_KEY));
+
     ensemble_config_init_GEN_PARAM(ensemble_config, config);
     ensemble_config_init_GEN_DATA(ensemble_config, config);
     ensemble_config_init_GEN_KW(ensemble_config, config);
@@ -763,6 +865,7 @@ ensemble_config_user_get_node(const ensemble_config_type *config,
 
 stringlist_type *
 ensemble_config_alloc_keylist(const ensemble_config_type *config) {
+    std::shared_lock<std::shared_mutex> lock(config->mutex);
     stringlist_type *s = stringlist_alloc_new();
     for (const auto &config_pair : config->config_nodes)
         stringlist_append_copy(s, config_pair.first.c_str());
@@ -780,6 +883,7 @@ ensemble_config_alloc_keylist(const ensemble_config_type *config) {
 std::vector<std::string>
 ensemble_config_keylist_from_var_type(const ensemble_config_type *config,
                                       int var_mask) {
+    std::shared_lock<std::shared_mutex> lock(config->mutex);
     std::vector<std::string> key_list;
 
     for (const auto &config_pair : config->config_nodes) {
@@ -797,6 +901,7 @@ ensemble_config_keylist_from_var_type(const ensemble_config_type *config,
 stringlist_type *
 ensemble_config_alloc_keylist_from_impl_type(const ensemble_config_type *config,
                                              ert_impl_type impl_type) {
+    std::shared_lock<std::shared_mutex> lock(config->mutex);
     stringlist_type *key_list = stringlist_alloc_new();
 
     for (const auto &config_pair : config->config_nodes) {
@@ -810,6 +915,7 @@ ensemble_config_alloc_keylist_from_impl_type(const ensemble_config_type *config,
 
 bool ensemble_config_has_impl_type(const ensemble_config_type *config,
                                    const ert_impl_type impl_type) {
+    std::shared_lock<std::shared_mutex> lock(config->mutex);
     for (const auto &config_pair : config->config_nodes) {
         if (impl_type == enkf_config_node_get_impl_type(config_pair.second))
             return true;
@@ -884,11 +990,10 @@ enkf_config_node_type *ensemble_config_add_gen_kw(ensemble_config_type *config,
 enkf_config_node_type *
 ensemble_config_add_summary(ensemble_config_type *ensemble_config,
                             const char *key, load_fail_type load_fail) {
-    enkf_config_node_type *config_node = NULL;
-
-    const auto node_it = ensemble_config->config_nodes.find(key);
-    if (node_it != ensemble_config->config_nodes.end()) {
-        config_node = node_it->second;
+    std::unique_lock<std::shared_mutex> lock(ensemble_config->mutex);
+    enkf_config_node_type *config_node =
+        ensemble_config_find_node__(ensemble_config, key);
+    if (config_node) {
         if (enkf_config_node_get_impl_type(config_node) != SUMMARY) {
             util_abort("%s: ensemble key:%s already exists - but it is not of "
                        "summary type\n",
@@ -901,7 +1006,7 @@ ensemble_config_add_summary(ensemble_config_type *ensemble_config,
 
     } else {
         config_node = enkf_config_node_alloc_summary(key, load_fail);
-        ensemble_config_add_node(ensemble_config, config_node);
+        ensemble_config_add_node__(ensemble_config, config_node);
     }
 
     return config_node;
@@ -957,6 +1062,7 @@ const summary_key_matcher_type *ensemble_config_get_summary_key_matcher(
 }
 
 int ensemble_config_get_size(const ensemble_config_type *ensemble_config) {
+    std::shared_lock<std::shared_mutex> lock(ensemble_config->mutex);
     return ensemble_config->config_nodes.size();
 }
 
@@ -967,8 +1073,15 @@ ensemble_config_forward_init(const ensemble_config_type *ens_config,
     auto result = LOAD_SUCCESSFUL;
     if (run_arg_get_step1(run_arg) == 0) {
         int iens = run_arg_get_iens(run_arg);
-        for (auto &config_pair : ens_config->config_nodes) {
-            enkf_config_node_type *config_node = config_pair.second;
+        // The nodes are copied out under the lock, so that the forward init
+        // below does not block the loading threads which add summary nodes.
+        std::vector<enkf_config_node_type *> config_nodes;
+        {
+            std::shared_lock<std::shared_mutex> lock(ens_config->mutex);
+            for (const auto &config_pair : ens_config->config_nodes)
+                config_nodes.push_back(config_pair.second);
+        }
+        for (enkf_config_node_type *config_node : config_nodes) {
             if (enkf_config_node_use_forward_init(config_node)) {
                 enkf_node_type *node = enkf_node_alloc(config_node);
                 enkf_fs_type *sim_fs = run_arg_get_sim_fs(run_arg);
@@ -85,10 +85,12 @@ void ert_template_free(ert_template_type *ert_template) {
 }
 
 void ert_template_instantiate(ert_template_type *ert_template, const char *path,
-                              const subst_list_type *arg_list) {
+                              const subst_list_type *arg_list,
+                              ert::runpath_manifest *manifest) {
     char *target_file =
         util_alloc_filename(path, ert_template->target_file, NULL);
-    template_instantiate(ert_template->tmpl, target_file, arg_list, true);
+    template_instantiate(ert_template->tmpl, target_file, arg_list, true,
+                         manifest);
     free(target_file);
 }
 
@@ -187,12 +189,13 @@ ert_template_type *ert_templates_add_template(ert_templates_type *ert_templates,
 
 void ert_templates_instansiate(ert_templates_type *ert_templates,
                                const char *path,
-                               const subst_list_type *arg_list) {
+                               const subst_list_type *arg_list,
+                               ert::runpath_manifest *manifest) {
     hash_iter_type *iter = hash_iter_alloc(ert_templates->templates);
     while (!hash_iter_is_complete(iter)) {
         ert_template_type *ert_template =
             (ert_template_type *)hash_iter_get_next_value(iter);
-        ert_template_instantiate(ert_template, path, arg_list);
+        ert_template_instantiate(ert_template, path, arg_list, manifest);
     }
     hash_iter_free(iter);
 }
@@ -35,6 +35,7 @@
 #include <ert/rms/rms_file.hpp>
 #include <ert/rms/rms_util.hpp>
 
+#include <ert/enkf/ecl_kw_writer.hpp>
 #include <ert/enkf/field.hpp>
 
 namespace fs = std::filesystem;
@@ -568,19 +569,6 @@ void field_ecl_write3D_fortio(const field_type *field, fortio_type *fortio,
     free(data);
 }
 
-static ecl_kw_type *field_alloc_ecl_kw_wrapper__(const field_type *field,
-                                                 void *data) {
-    const int data_size = field_config_get_volume(field->config);
-    const ecl_data_type target_type = field_config_get_ecl_data_type(
-        field->config); /* Could/should in principle be input */
-
-    ecl_kw_type *ecl_kw =
-        ecl_kw_alloc_new_shared(field_config_get_ecl_kw_name(field->config),
-                                data_size, target_type, data);
-
-    return ecl_kw;
-}
-
 void field_ecl_grdecl_export(const field_type *field, FILE *stream,
                              const char *init_file) {
     const int data_size = field_config_get_volume(field->config);
@@ -590,9 +578,8 @@ void field_ecl_grdecl_export(const field_type *field, FILE *stream,
         field_config_get_ecl_data_type(field->config);
     void *data = __field_alloc_3D_data(field, data_size, false, data_type,
                                        target_type, init_file);
-    ecl_kw_type *ecl_kw = field_alloc_ecl_kw_wrapper__(field, data);
-    ecl_kw_fprintf_grdecl(ecl_kw, stream);
-    ecl_kw_free(ecl_kw);
+    ert::fwrite_grdecl(stream, field_config_get_ecl_kw_name(field->config),
+                       target_type, data_size, data);
     free(data);
 }
 
@@ -727,18 +714,26 @@ void field_export(const field_type *__field, const char *file,
     /*  Writes the field to in ecl_kw format to a new file.  */
     if ((file_type == ECL_KW_FILE_ALL_CELLS) ||
         (file_type == ECL_KW_FILE_ACTIVE_CELLS)) {
-        fortio_type *fortio;
-        bool fmt_file =
-            false; /* For formats which support both formatted and unformatted output this is hardwired to unformatted. */
-
-        fortio = fortio_open_writer(file, fmt_file, ECL_ENDIAN_FLIP);
-
-        if (file_type == ECL_KW_FILE_ALL_CELLS)
-            field_ecl_write3D_fortio(field, fortio, init_file);
-        else
-            field_ecl_write1D_fortio(field, fortio);
+        /* The same content as field_ecl_write3D_fortio() and
+           field_ecl_write1D_fortio() to an unformatted fortio, but the
+           records are written to the file in one go. */
+        const char *kw = field_config_get_ecl_kw_name(field->config);
+        const ecl_data_type data_type =
+            field_config_get_ecl_data_type(field->config);
+        FILE *stream = util_fopen(file, "w");
+
+        if (file_type == ECL_KW_FILE_ALL_CELLS) {
+            const int data_size = field_config_get_volume(field->config);
+            void *data = __field_alloc_3D_data(field, data_size, false,
+                                               data_type, data_type, init_file);
+            ert::fwrite_ecl_kw(stream, kw, data_type, data_size, data);
+            free(data);
+        } else
+            ert::fwrite_ecl_kw(stream, kw, data_type,
+                               field_config_get_data_size(field->config),
+                               field->data);
 
-        fortio_fclose(fortio);
+        fclose(stream);
     } else if (file_type == ECL_GRDECL_FILE) {
         /* Writes the field to a new grdecl file. */
         auto stream = mkdir_fopen(fs::path(file), "w");
@@ -17,17 +17,26 @@
 */
 
 #include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
 #include <ert/util/stringlist.h>
 #include <ert/util/type_macros.h>
 
 #include <ert/enkf/enkf_defaults.hpp>
 #include <ert/enkf/forward_load_context.hpp>
 #include <ert/enkf/run_arg.hpp>
+#include <ert/enkf/summary_reader.hpp>
 #include <ert/res_util/memory.hpp>
+#include <ert/res_util/metric.hpp>
 #include <fmt/format.h>
 
 #define FORWARD_LOAD_CONTEXT_TYPE_ID 644239127
 
+namespace fs = std::filesystem;
+
 static auto logger = ert::get_logger("enkf.forward_load_context");
 
 struct forward_load_context_struct {
@@ -39,6 +48,8 @@ struct forward_load_context_struct {
     const run_arg_type *run_arg;
     /** Can be NULL */
     const ecl_config_type *ecl_config;
+    /** The summary vectors to load; all when NULL. */
+    const summary_key_matcher_type *summary_key_matcher;
 
     int step2;
     /** Messages is managed by external scope - can be NULL */
@@ -48,6 +59,10 @@ struct forward_load_context_struct {
     int load_step;
     fw_load_status load_result;
     bool ecl_active;
+    /** The names of the files found in each directory of the runpath which
+     * has been looked in; see forward_load_context_file_exists(). */
+    mutable std::unordered_map<std::string, std::unordered_set<std::string>>
+        directory_listings;
 };
 
 UTIL_IS_INSTANCE_FUNCTION(forward_load_context, FORWARD_LOAD_CONTEXT_TYPE_ID);
@@ -94,11 +109,28 @@ forward_load_context_load_ecl_sum(forward_load_context_type *load_context) {
             {
                 ert::utils::scoped_memory_logger memlogger(
                     logger, fmt::format("lazy={}", lazy_load));
+                ert::utils::ScopedTimer timer("summary.read");
+                std::error_code ec;
+                for (const char *file : {header_file, unified_file}) {
+                    auto size = fs::file_size(file, ec);
+                    if (!ec)
+                        ert::utils::Profile::count_bytes("summary.read", size);
+                }
 
-                int file_options = 0;
-                summary = ecl_sum_fread_alloc(
-                    header_file, data_files, SUMMARY_KEY_JOIN_STRING,
-                    include_restart, lazy_load, file_options);
+                // Only the vectors which are going to be internalized are
+                // read, unless the files can only be read in full.
+                if (load_context->summary_key_matcher && !lazy_load &&
+                    !fmt_file)
+                    summary = summary_reader_fread_alloc(
+                        header_file, unified_file, SUMMARY_KEY_JOIN_STRING,
+                        load_context->summary_key_matcher);
+
+                if (!summary) {
+                    int file_options = 0;
+                    summary = ecl_sum_fread_alloc(
+                        header_file, data_files, SUMMARY_KEY_JOIN_STRING,
+                        include_restart, lazy_load, file_options);
+                }
             }
 
             {
@@ -135,8 +167,19 @@ forward_load_context_load_ecl_sum(forward_load_context_type *load_context) {
 forward_load_context_type *
 forward_load_context_alloc(const run_arg_type *run_arg, bool load_summary,
                            const ecl_config_type *ecl_config) {
-    forward_load_context_type *load_context =
-        (forward_load_context_type *)util_malloc(sizeof *load_context);
+    return forward_load_context_alloc_matching(run_arg, load_summary,
+                                               ecl_config, NULL);
+}
+
+/**
+   As forward_load_context_alloc(), but only the summary vectors matched by
+   matcher are loaded; the other vectors are not in the ecl_sum instance.
+*/
+forward_load_context_type *forward_load_context_alloc_matching(
+    const run_arg_type *run_arg, bool load_summary,
+    const ecl_config_type *ecl_config,
+    const summary_key_matcher_type *matcher) {
+    forward_load_context_type *load_context = new forward_load_context_type();
     UTIL_TYPE_ID_INIT(load_context, FORWARD_LOAD_CONTEXT_TYPE_ID);
 
     load_context->ecl_active = false;
@@ -147,6 +190,7 @@ forward_load_context_alloc(const run_arg_type *run_arg, bool load_summary,
         -1; // Invalid - must call forward_load_context_select_step()
     load_context->load_result = LOAD_SUCCESSFUL;
     load_context->ecl_config = ecl_config;
+    load_context->summary_key_matcher = matcher;
     if (ecl_config)
         load_context->ecl_active = ecl_config_active(ecl_config);
 
@@ -173,7 +217,7 @@ void forward_load_context_free(forward_load_context_type *load_context) {
     if (load_context->ecl_sum)
         ecl_sum_free(load_context->ecl_sum);
 
-    free(load_context);
+    delete load_context;
 }
 
 bool forward_load_context_load_restart_file(
@@ -216,6 +260,41 @@ bool forward_load_context_load_restart_file(
     }
 }
 
+/**
+   Checks whether the result file filename exists. When loading the results
+   of a realization the directory of filename is only listed the first time,
+   and the following checks in the same directory are looked up in the
+   listing; this saves a stat() call for every file which is probed. The
+   listing is not refreshed, i.e. files created after the first check in a
+   directory are not seen.
+*/
+bool forward_load_context_file_exists(
+    const forward_load_context_type *load_context, const char *filename) {
+    if (!load_context->run_arg)
+        return fs::exists(filename);
+
+    ert::utils::ScopedTimer timer("file_probe");
+    const fs::path path(filename);
+    std::string directory = path.parent_path();
+    if (directory.empty())
+        directory = ".";
+
+    auto iter = load_context->directory_listings.find(directory);
+    if (iter == load_context->directory_listings.end()) {
+        std::unordered_set<std::string> listing;
+        std::error_code ec;
+        for (const auto &entry : fs::directory_iterator(directory, ec)) {
+            // Symlinks are followed, as by fs::exists()
+            if (!entry.is_symlink(ec) || entry.exists(ec))
+                listing.insert(entry.path().filename());
+        }
+        iter = load_context->directory_listings
+                   .emplace(directory, std::move(listing))
+                   .first;
+    }
+    return iter->second.count(path.filename()) > 0;
+}
+
 const ecl_sum_type *forward_load_context_get_ecl_sum(
     const forward_load_context_type *load_context) {
     return load_context->ecl_sum;
@@ -24,6 +24,8 @@
 
 #include <ert/ecl/ecl_type.h>
 
+#include <ert/res_util/text_scanner.hpp>
+
 #include <ert/enkf/gen_common.hpp>
 #include <ert/enkf/gen_data_config.hpp>
 
@@ -32,54 +34,50 @@
    by both the gen_data and gen_obs objects.
 */
 
-void *gen_common_fscanf_alloc(const char *file, ecl_data_type load_data_type,
-                              int *size) {
-    FILE *stream = util_fopen(file, "r");
-    int sizeof_ctype = ecl_type_get_sizeof_ctype(load_data_type);
+template <typename T>
+static T *gen_common_scan_alloc(ert::text_scanner &scanner, const char *file,
+                                int *size) {
     int buffer_elements = *size;
     int current_size = 0;
-    int fscanf_return = 1; /* To keep the compiler happy .*/
-    void *buffer;
 
     if (buffer_elements == 0)
         buffer_elements = 100;
 
-    buffer = util_calloc(buffer_elements, sizeof_ctype); // CXX_CAST_ERROR
-    {
-        do {
-            if (ecl_type_is_float(load_data_type)) {
-                float *float_buffer = (float *)buffer;
-                fscanf_return =
-                    fscanf(stream, "%g", &float_buffer[current_size]);
-            } else if (ecl_type_is_double(load_data_type)) {
-                double *double_buffer = (double *)buffer;
-                fscanf_return =
-                    fscanf(stream, "%lg", &double_buffer[current_size]);
-            } else if (ecl_type_is_int(load_data_type)) {
-                int *int_buffer = (int *)buffer;
-                fscanf_return = fscanf(stream, "%d", &int_buffer[current_size]);
-            } else
-                util_abort("%s: god dammit - internal error \n", __func__);
-
-            if (fscanf_return == 1)
-                current_size += 1;
-
-            if (current_size == buffer_elements) {
-                buffer_elements *= 2;
-                buffer = util_realloc(buffer, buffer_elements * sizeof_ctype);
-            }
-        } while (fscanf_return == 1);
+    T *buffer = (T *)util_calloc(buffer_elements, sizeof *buffer);
+    T value;
+    while (scanner.scan(value)) {
+        buffer[current_size] = value;
+        current_size += 1;
+
+        if (current_size == buffer_elements) {
+            buffer_elements *= 2;
+            buffer =
+                (T *)util_realloc(buffer, buffer_elements * sizeof *buffer);
+        }
     }
-    if (fscanf_return != EOF)
-        util_abort("%s: scanning of %s terminated before EOF was reached -- "
-                   "fix your file.\n",
-                   __func__, file);
+    if (!scanner.at_end())
+        util_abort("%s: scanning of %s terminated before EOF was reached at "
+                   "line:%d column:%d -- fix your file.\n",
+                   __func__, file, scanner.line(), scanner.column());
 
-    fclose(stream);
     *size = current_size;
     return buffer;
 }
 
+void *gen_common_fscanf_alloc(const char *file, ecl_data_type load_data_type,
+                              int *size) {
+    ert::text_scanner scanner(file);
+    if (ecl_type_is_float(load_data_type))
+        return gen_common_scan_alloc<float>(scanner, file, size);
+    else if (ecl_type_is_double(load_data_type))
+        return gen_common_scan_alloc<double>(scanner, file, size);
+    else if (ecl_type_is_int(load_data_type))
+        return gen_common_scan_alloc<int>(scanner, file, size);
+
+    util_abort("%s: god dammit - internal error \n", __func__);
+    return NULL;
+}
+
 void *gen_common_fread_alloc(const char *file, ecl_data_type load_data_type,
                              int *size) {
     const int max_read_size = 100000;
@@ -17,7 +17,6 @@
 */
 
 #include <cmath>
-#include <filesystem>
 
 #include <Eigen/Dense>
 #include <stdio.h>
@@ -29,6 +28,7 @@
 #include <ert/ecl/ecl_sum.h>
 
 #include <ert/logging.hpp>
+#include <ert/res_util/text_scanner.hpp>
 
 #include <ert/enkf/enkf_macros.hpp>
 #include <ert/enkf/enkf_serialize.hpp>
@@ -37,7 +37,6 @@
 #include <ert/enkf/gen_data.hpp>
 #include <ert/enkf/gen_data_config.hpp>
 
-namespace fs = std::filesystem;
 static auto logger = ert::get_logger("enkf");
 
 /**
@@ -241,8 +240,10 @@ static void gen_data_set_data__(gen_data_type *gen_data, int size,
     }
 }
 
-static bool gen_data_fload_active__(gen_data_type *gen_data,
-                                    const char *filename, int size) {
+static bool
+gen_data_fload_active__(gen_data_type *gen_data, const char *filename,
+                        int size,
+                        const forward_load_context_type *load_context) {
     /*
      Look for file @filename_active - if that file is found it is
      interpreted as a an active|inactive mask created by the forward
@@ -261,28 +262,33 @@ static bool gen_data_fload_active__(gen_data_type *gen_data,
         bool_vector_iset(gen_data->active_mask, size - 1, true);
         {
             char *active_file = util_alloc_sprintf("%s_active", filename);
-            if (fs::exists(active_file)) {
+            if (forward_load_context_file_exists(load_context, active_file)) {
                 file_exists = true;
-                FILE *stream = util_fopen(active_file, "r");
+                ert::text_scanner scanner(active_file);
+                bool *active = bool_vector_get_ptr(gen_data->active_mask);
                 int active_int;
                 for (int index = 0; index < size; index++) {
-                    if (fscanf(stream, "%d", &active_int) == 1) {
+                    if (scanner.scan(active_int)) {
                         if (active_int == 1)
-                            bool_vector_iset(gen_data->active_mask, index,
-                                             true);
+                            active[index] = true;
                         else if (active_int == 0)
-                            bool_vector_iset(gen_data->active_mask, index,
-                                             false);
+                            active[index] = false;
                         else
                             util_abort("%s: error when loading active mask "
-                                       "from:%s only 0 and 1 allowed \n",
-                                       __func__, active_file);
-                    } else
+                                       "from:%s only 0 and 1 allowed - found "
+                                       "%d at line:%d \n",
+                                       __func__, active_file, active_int,
+                                       scanner.line());
+                    } else if (scanner.at_end())
                         util_abort("%s: error when loading active mask from:%s "
                                    "- file not long enough.\n",
                                    __func__, active_file);
+                    else
+                        util_abort("%s: error when loading active mask from:%s "
+                                   "- invalid value at line:%d column:%d \n",
+                                   __func__, active_file, scanner.line(),
+                                   scanner.column());
                 }
-                fclose(stream);
                 logger->info("GEN_DATA({}): active information loaded from:{}.",
                              gen_data_get_key(gen_data), active_file);
             } else
@@ -313,7 +319,8 @@ static bool gen_data_fload_active__(gen_data_type *gen_data,
 bool gen_data_fload_with_report_step(
     gen_data_type *gen_data, const char *filename,
     const forward_load_context_type *load_context) {
-    bool file_exists = fs::exists(filename);
+    bool file_exists =
+        forward_load_context_file_exists(load_context, filename);
     void *buffer = NULL;
     if (file_exists) {
         ecl_type_enum load_type;
@@ -327,7 +334,7 @@ bool gen_data_fload_with_report_step(
         logger->info("GEN_DATA({}): loading from: {}   size:{}",
                      gen_data_get_key(gen_data), filename, size);
         if (size > 0) {
-            gen_data_fload_active__(gen_data, filename, size);
+            gen_data_fload_active__(gen_data, filename, size, load_context);
         } else {
             bool_vector_reset(gen_data->active_mask);
         }
@@ -475,6 +482,14 @@ static void gen_data_assert_index(const gen_data_type *gen_data, int index) {
                    index, current_size);
 }
 
+/**
+   Raw view of the data buffer; the element type is given by
+   gen_data_config_get_internal_data_type().
+*/
+const void *gen_data_get_ptr(const gen_data_type *gen_data) {
+    return gen_data->data;
+}
+
 double gen_data_iget_double(const gen_data_type *gen_data, int index) {
     gen_data_assert_index(gen_data, index);
     {
@@ -86,6 +86,9 @@ struct gen_data_config_struct {
     int ens_size;
     bool mask_modified;
     bool_vector_type *active_mask;
+    /** Incremented every time the content of active_mask changes; lets
+     * observations cache derived index lists across realizations. */
+    int active_mask_version;
     int active_report_step;
 };
 
@@ -181,6 +184,7 @@ static gen_data_config_type *gen_data_config_alloc(const char *key,
     config->active_mask = bool_vector_alloc(
         0,
         true); /* Elements are explicitly set to FALSE - this MUST default to true. */
+    config->active_mask_version = 0;
     config->active_report_step = -1;
     config->ens_size = -1;
     config->last_read_fs = NULL;
@@ -257,6 +261,11 @@ gen_data_config_get_active_mask(const gen_data_config_type *config) {
         return NULL; /* GEN_PARAM instance will never be deactivated by the forward model. */
 }
 
+int gen_data_config_get_active_mask_version(
+    const gen_data_config_type *config) {
+    return config->active_mask_version;
+}
+
 bool gen_data_config_set_template(gen_data_config_type *config,
                                   const char *template_ecl_file,
                                   const char *template_data_key) {
@@ -432,6 +441,7 @@ update_config_to_datamask(gen_data_config_type *config,
             config->active_mask,
             int_vector_iget(config->data_size_vector, report_step) - 1, true);
         config->mask_modified = true;
+        config->active_mask_version++;
     }
 
     // set config inactive according to data_mask
@@ -440,6 +450,7 @@ update_config_to_datamask(gen_data_config_type *config,
             continue;
         bool_vector_iset(config->active_mask, i, false);
         config->mask_modified = true;
+        config->active_mask_version++;
     }
 
     if (!config->mask_modified)
@@ -519,6 +530,7 @@ void gen_data_config_load_active(gen_data_config_type *config, enkf_fs_type *fs,
             if (stream != NULL) {
                 bool_vector_fread(config->active_mask, stream);
                 fclose(stream);
+                config->active_mask_version++;
             } else {
                 int gen_data_size =
                     int_vector_safe_iget(config->data_size_vector, report_step);
@@ -548,6 +560,7 @@ void gen_data_config_load_active(gen_data_config_type *config, enkf_fs_type *fs,
                     bool_vector_reset(config->active_mask);
                     bool_vector_iset(config->active_mask, gen_data_size - 1,
                                      true);
+                    config->active_mask_version++;
                 }
             }
             free(filename);
@@ -21,8 +21,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <string>
 
 #include <ert/res_util/subst_list.hpp>
+#include <ert/res_util/text_scanner.hpp>
 #include <ert/util/buffer.h>
 #include <ert/util/util.h>
 
@@ -315,25 +317,18 @@ const char *gen_kw_get_name(const gen_kw_type *gen_kw, int kw_nr) {
 
 */
 static bool gen_kw_fload(gen_kw_type *gen_kw, const char *filename) {
-    FILE *stream = util_fopen__(filename, "r");
-    if (stream) {
-        const int size = gen_kw_config_get_data_size(gen_kw->config);
-        bool readOK = true;
-
-        /* First try reading all the data as one long vector. */
-        {
-            int index = 0;
-            while ((index < size) && readOK) {
-                double value;
-                if (fscanf(stream, "%lg", &value) == 1)
-                    gen_kw->data[index] = value;
-                else
-                    readOK = false;
-                index++;
-            }
-        }
+    if (!util_file_exists(filename))
+        return false;
 
-        /*
+    ert::text_scanner scanner(filename);
+    const int size = gen_kw_config_get_data_size(gen_kw->config);
+    bool readOK = true;
+
+    /* First try reading all the data as one long vector. */
+    for (int index = 0; index < size && readOK; index++)
+        readOK = scanner.scan(gen_kw->data[index]);
+
+    /*
        OK - rewind and try again with interlaced key + value
        pairs. Observe that we still require that ALL the elements in the
        gen_kw instance are set, i.e. it is not allowed to read only some
@@ -342,45 +337,27 @@ static bool gen_kw_fload(gen_kw_type *gen_kw, const char *filename) {
        The code will be fooled (and give undefined erronous results) if
        the same key appears several times. Be polite!
     */
-
-        if (!readOK) {
-            int counter = 0;
-            readOK = true;
-            fseek(stream, 0, SEEK_SET);
-
-            while ((counter < size) && readOK) {
-                char key[128];
-                double value;
-                int fscanf_return = fscanf(stream, "%s %lg", key, &value);
-
-                if (fscanf_return == 2) {
-                    int index = gen_kw_config_get_index(gen_kw->config, key);
-                    if (index >= 0)
-                        gen_kw->data[index] = value;
-                    else
-                        util_abort(
-                            "%s: key:%s not recognized as part of GEN_KW "
-                            "instance - error when reading file:%s \n",
-                            __func__, key, filename);
-                    counter++;
-                } else {
-                    util_abort("%s: failed to read (key,value) pair at line:%d "
-                               "in file:%s \n",
-                               __func__, util_get_current_linenr(stream),
-                               filename);
-                    readOK = false;
-                }
-            }
+    if (!readOK) {
+        scanner.rewind();
+        for (int counter = 0; counter < size; counter++) {
+            std::string key;
+            double value;
+            if (!scanner.scan(key) || !scanner.scan(value))
+                util_abort("%s: failed to read (key,value) pair at line:%d "
+                           "column:%d in file:%s \n",
+                           __func__, scanner.line(), scanner.column(),
+                           filename);
+
+            int index = gen_kw_config_get_index(gen_kw->config, key.c_str());
+            if (index >= 0)
+                gen_kw->data[index] = value;
+            else
+                util_abort("%s: key:%s not recognized as part of GEN_KW "
+                           "instance - error when reading file:%s \n",
+                           __func__, key.c_str(), filename);
         }
-
-        if (!readOK)
-            util_abort("%s: failed loading from file:%s \n", __func__,
-                       filename);
-
-        fclose(stream);
-        return true;
-    } else
-        return false;
+    }
+    return true;
 }
 
 /**
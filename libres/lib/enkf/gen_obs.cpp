@@ -20,7 +20,10 @@
    See the overview documentation of the observation system in
    enkf_obs.c
 */
+#include <memory>
+#include <mutex>
 #include <stdlib.h>
+#include <vector>
 
 #include <ert/util/string_util.h>
 #include <ert/util/util.h>
@@ -55,6 +58,22 @@
   be returned, whereas when the function gen_obs_measure() is used the
   std_scaling will be incorporated in the result.
 */
+namespace {
+/**
+   Precompiled mapping from a gen_data vector to the observation vector;
+   element i is gathered from data[data_index[i]] into observation row
+   obs_index[i]. Elements deactivated by the forward model are left out,
+   so applying the index is a branch free gather. The index is only valid
+   for the active mask version and data size it was compiled for.
+*/
+struct gen_obs_index_type {
+    int mask_version;
+    int data_size;
+    std::vector<int> obs_index;
+    std::vector<int> data_index;
+};
+} // namespace
+
 struct gen_obs_struct {
     UTIL_TYPE_ID_DECLARATION;
     /** This is the total size of the observation vector. */
@@ -80,6 +99,10 @@ struct gen_obs_struct {
      * observation file. */
     gen_data_file_format_type obs_format;
     gen_data_config_type *data_config;
+
+    /** Cached result of gen_obs_get_index(). */
+    mutable std::shared_ptr<const gen_obs_index_type> index;
+    mutable std::mutex index_lock;
 };
 
 static UTIL_SAFE_CAST_FUNCTION_CONST(
@@ -93,7 +116,7 @@ static UTIL_SAFE_CAST_FUNCTION_CONST(
     free(gen_obs->obs_key);
     free(gen_obs->std_scaling);
 
-    free(gen_obs);
+    delete gen_obs;
 }
 
 static double IGET_SCALED_STD(const gen_obs_type *gen_obs, int index) {
@@ -116,6 +139,7 @@ static double IGET_SCALED_STD(const gen_obs_type *gen_obs, int index) {
 */
 static void gen_obs_set_data(gen_obs_type *gen_obs, int buffer_size,
                              const double *buffer) {
+    gen_obs->index.reset();
     gen_obs->obs_size = buffer_size / 2;
     gen_obs->obs_data = (double *)util_realloc(
         gen_obs->obs_data, gen_obs->obs_size * sizeof *gen_obs->obs_data);
@@ -166,6 +190,7 @@ void gen_obs_set_scalar(gen_obs_type *gen_obs, double scalar_value,
 
 void gen_obs_attach_data_index(gen_obs_type *obs,
                                const int_vector_type *data_index) {
+    obs->index.reset();
     free(obs->data_index_list);
     obs->data_index_list = int_vector_alloc_data_copy(data_index);
     obs->observe_all_data = false;
@@ -173,6 +198,7 @@ void gen_obs_attach_data_index(gen_obs_type *obs,
 
 void gen_obs_load_data_index(gen_obs_type *obs, const char *data_index_file) {
     /* Parsing an a file with integers. */
+    obs->index.reset();
     free(obs->data_index_list);
     obs->data_index_list = (int *)gen_common_fscanf_alloc(
         data_index_file, ECL_INT, &obs->obs_size);
@@ -191,7 +217,7 @@ void gen_obs_parse_data_index(gen_obs_type *obs,
 
 gen_obs_type *gen_obs_alloc__(const gen_data_config_type *data_config,
                               const char *obs_key) {
-    gen_obs_type *obs = (gen_obs_type *)util_malloc(sizeof *obs);
+    gen_obs_type *obs = new gen_obs_type();
     UTIL_TYPE_ID_INIT(obs, GEN_OBS_TYPE_ID);
     obs->obs_data = NULL;
     obs->obs_std = NULL;
@@ -250,51 +276,91 @@ static void gen_obs_assert_data_size(const gen_obs_type *gen_obs,
   */
 }
 
+/**
+   Returns the gather index for the current active mask of the data
+   config, compiling it only when the mask or the data size has changed
+   since the last call. Typically the index is compiled once per report
+   step and then reused for all realizations.
+*/
+static std::shared_ptr<const gen_obs_index_type>
+gen_obs_get_index(const gen_obs_type *gen_obs, const gen_data_type *gen_data) {
+    const bool_vector_type *forward_model_active =
+        gen_data_config_get_active_mask(gen_obs->data_config);
+    int mask_version =
+        gen_data_config_get_active_mask_version(gen_obs->data_config);
+    int data_size = gen_data_get_size(gen_data);
+
+    std::lock_guard<std::mutex> guard(gen_obs->index_lock);
+    if (gen_obs->index && gen_obs->index->mask_version == mask_version &&
+        gen_obs->index->data_size == data_size)
+        return gen_obs->index;
+
+    auto index = std::make_shared<gen_obs_index_type>();
+    index->mask_version = mask_version;
+    index->data_size = data_size;
+    index->obs_index.reserve(gen_obs->obs_size);
+    index->data_index.reserve(gen_obs->obs_size);
+    for (int iobs = 0; iobs < gen_obs->obs_size; iobs++) {
+        int data_index = gen_obs->data_index_list[iobs];
+        if ((data_index < 0) || (data_index >= data_size))
+            util_abort("%s: index:%d invalid. Valid range: [0,%d) \n",
+                       __func__, data_index, data_size);
+
+        if (forward_model_active &&
+            !bool_vector_iget(forward_model_active, data_index))
+            continue; /* Forward model has deactivated this index - just continue. */
+
+        index->obs_index.push_back(iobs);
+        index->data_index.push_back(data_index);
+    }
+    gen_obs->index = index;
+    return index;
+}
+
+template <typename T>
+static double gen_obs_chi2__(const gen_obs_type *gen_obs,
+                             const gen_obs_index_type &index, const T *data) {
+    double sum_chi2 = 0;
+    for (size_t i = 0; i < index.obs_index.size(); i++) {
+        int iobs = index.obs_index[i];
+        double x = (data[index.data_index[i]] - gen_obs->obs_data[iobs]) /
+                   gen_obs->obs_std[iobs];
+        sum_chi2 += x * x;
+    }
+    return sum_chi2;
+}
+
 double gen_obs_chi2(const gen_obs_type *gen_obs, const gen_data_type *gen_data,
                     node_id_type node_id) {
     gen_obs_assert_data_size(gen_obs, gen_data);
-    {
-        const bool_vector_type *forward_model_active =
-            gen_data_config_get_active_mask(gen_obs->data_config);
-        double sum_chi2 = 0;
-        for (int iobs = 0; iobs < gen_obs->obs_size; iobs++) {
-            int data_index = gen_obs->data_index_list[iobs];
-            if (forward_model_active &&
-                (bool_vector_iget(forward_model_active, data_index) == false))
-                continue; /* Forward model has deactivated this index - just continue. */
-            {
-                double d = gen_data_iget_double(gen_data, data_index);
-                double x =
-                    (d - gen_obs->obs_data[iobs]) / gen_obs->obs_std[iobs];
-                sum_chi2 += x * x;
-            }
-        }
-        return sum_chi2;
-    }
+    auto index = gen_obs_get_index(gen_obs, gen_data);
+    const void *data = gen_data_get_ptr(gen_data);
+    if (ecl_type_is_double(
+            gen_data_config_get_internal_data_type(gen_obs->data_config)))
+        return gen_obs_chi2__(gen_obs, *index,
+                              static_cast<const double *>(data));
+    else
+        return gen_obs_chi2__(gen_obs, *index,
+                              static_cast<const float *>(data));
 }
 
 void gen_obs_measure(const gen_obs_type *gen_obs, const gen_data_type *gen_data,
                      node_id_type node_id, meas_data_type *meas_data) {
     gen_obs_assert_data_size(gen_obs, gen_data);
-    {
-        meas_block_type *meas_block =
-            meas_data_add_block(meas_data, gen_obs->obs_key,
-                                node_id.report_step, gen_obs->obs_size);
-        const bool_vector_type *forward_model_active =
-            gen_data_config_get_active_mask(gen_obs->data_config);
-
-        for (int iobs = 0; iobs < gen_obs->obs_size; iobs++) {
-            int data_index = gen_obs->data_index_list[iobs];
-
-            if (forward_model_active != NULL) {
-                if (!bool_vector_iget(forward_model_active, data_index))
-                    continue; /* Forward model has deactivated this index - just continue. */
-            }
-
-            meas_block_iset(meas_block, node_id.iens, iobs,
-                            gen_data_iget_double(gen_data, data_index));
-        }
-    }
+    auto index = gen_obs_get_index(gen_obs, gen_data);
+    meas_block_type *meas_block = meas_data_add_block(
+        meas_data, gen_obs->obs_key, node_id.report_step, gen_obs->obs_size);
+
+    const void *data = gen_data_get_ptr(gen_data);
+    if (ecl_type_is_double(
+            gen_data_config_get_internal_data_type(gen_obs->data_config)))
+        meas_block_iset_gather(meas_block, node_id.iens, index->obs_index,
+                               index->data_index,
+                               static_cast<const double *>(data));
+    else
+        meas_block_iset_gather(meas_block, node_id.iens, index->obs_index,
+                               index->data_index,
+                               static_cast<const float *>(data));
 }
 
 C_USED void gen_obs_get_observations(gen_obs_type *gen_obs,
@@ -0,0 +1,98 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'load_report.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <cstdio>
+
+#include <fmt/format.h>
+
+#include <ert/util/util.h>
+
+#include <ert/enkf/load_report.hpp>
+
+namespace {
+
+void append_phases(
+    std::string &json,
+    const std::map<std::string, ert::utils::Profile::Phase> &phases) {
+    json += "{";
+    for (auto iter = phases.begin(); iter != phases.end(); ++iter) {
+        if (iter != phases.begin())
+            json += ",";
+        json += fmt::format("\n    \"{}\": {{\"seconds\": {:.6f}, "
+                            "\"calls\": {}, \"bytes\": {}}}",
+                            iter->first, iter->second.seconds,
+                            iter->second.calls, iter->second.bytes);
+    }
+    json += "}";
+}
+
+} // namespace
+
+namespace ert {
+
+void load_report::add(int iens, fw_load_status status,
+                      const utils::Profile &profile) {
+    std::lock_guard<std::mutex> guard(mutex);
+    realizations[iens] = {status, profile};
+}
+
+size_t load_report::size() const {
+    std::lock_guard<std::mutex> guard(mutex);
+    return realizations.size();
+}
+
+std::string load_report::to_json() const {
+    std::lock_guard<std::mutex> guard(mutex);
+    std::map<std::string, utils::Profile::Phase> total;
+    std::string json = "{\"realizations\": {";
+    for (auto iter = realizations.begin(); iter != realizations.end();
+         ++iter) {
+        const auto &[iens, realization] = *iter;
+        if (iter != realizations.begin())
+            json += ",";
+        json += fmt::format(
+            "\n  \"{}\": {{\"status\": \"{}\", \"phases\": ", iens,
+            realization.status == LOAD_SUCCESSFUL ? "LOAD_SUCCESSFUL"
+                                                  : "LOAD_FAILURE");
+        append_phases(json, realization.profile.phases());
+        json += "}";
+
+        for (const auto &[name, phase] : realization.profile.phases()) {
+            auto &sum = total[name];
+            sum.seconds += phase.seconds;
+            sum.calls += phase.calls;
+            sum.bytes += phase.bytes;
+        }
+    }
+    json += "},\n\"total\": ";
+    append_phases(json, total);
+    json += "}\n";
+    return json;
+}
+
+void load_report::fwrite(const std::string &filename) const {
+    const std::string json = to_json();
+    std::lock_guard<std::mutex> guard(write_mutex);
+    const std::string tmp_file = filename + ".tmp";
+    FILE *stream = util_fopen(tmp_file.c_str(), "w");
+    std::fwrite(json.data(), 1, json.size(), stream);
+    fclose(stream);
+    std::rename(tmp_file.c_str(), filename.c_str());
+}
+
+} // namespace ert
@@ -0,0 +1,97 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'load_service.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <utility>
+
+#include <ert/enkf/enkf_state.hpp>
+#include <ert/enkf/load_service.hpp>
+
+namespace ert {
+
+load_service::load_service(size_t num_threads)
+    : load_service(num_threads, enkf_state_complete_forward_modelOK) {}
+
+load_service::load_service(size_t num_threads, load_function load)
+    : load(std::move(load)), pool(num_threads) {}
+
+std::future<bool> load_service::submit(const res_config_type *res_config,
+                                       run_arg_type *run_arg) {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        num_submitted++;
+    }
+    return pool.submit([this, res_config, run_arg] {
+        bool ok = false;
+        try {
+            ok = load(res_config, run_arg);
+        } catch (...) {
+            complete(false);
+            throw;
+        }
+        complete(ok);
+        return ok;
+    });
+}
+
+void load_service::complete(bool ok) {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (ok)
+            num_loaded++;
+        else
+            num_failed++;
+    }
+    all_complete.notify_all();
+}
+
+void load_service::wait() const {
+    std::unique_lock<std::mutex> lock(mutex);
+    all_complete.wait(lock, [this] {
+        return num_loaded + num_failed == num_submitted;
+    });
+}
+
+size_t load_service::submitted() const {
+    std::lock_guard<std::mutex> guard(mutex);
+    return num_submitted;
+}
+
+size_t load_service::loaded() const {
+    std::lock_guard<std::mutex> guard(mutex);
+    return num_loaded;
+}
+
+size_t load_service::failed() const {
+    std::lock_guard<std::mutex> guard(mutex);
+    return num_failed;
+}
+
+size_t load_service::pending() const {
+    std::lock_guard<std::mutex> guard(mutex);
+    return num_submitted - num_loaded - num_failed;
+}
+
+load_service &load_service::instance() {
+    // Loading is mainly io-bound; the limit is the same as for
+    // enkf_main_load_from_run_context().
+    const size_t max_load_threads = 100;
+    static load_service service(worker_pool::io_bound_size(max_load_threads));
+    return service;
+}
+
+} // namespace ert
@@ -0,0 +1,174 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'load_sources.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include <ert/res_util/file_utils.hpp>
+#include <ert/util/util.h>
+
+#include <ert/enkf/load_sources.hpp>
+
+namespace fs = std::filesystem;
+
+#define LOAD_SOURCES_ID 771203
+
+namespace {
+const uint64_t hash_prime = 0x100000001b3;
+
+/**
+   Hashes the first and the last sample_size bytes of the file, or all of it
+   if it is smaller. Returns false if the file can not be read.
+*/
+bool hash_file_samples(const std::string &filename, size_t sample_size,
+                       uint64_t &hash) {
+    std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+    if (!stream)
+        return false;
+
+    const size_t size = stream.tellg();
+    std::vector<char> sample(std::min(size, 2 * sample_size));
+    stream.seekg(0);
+    if (size <= 2 * sample_size)
+        stream.read(sample.data(), sample.size());
+    else {
+        stream.read(sample.data(), sample_size);
+        stream.seekg(size - sample_size);
+        stream.read(sample.data() + sample_size, sample_size);
+    }
+    if (!stream)
+        return false;
+
+    hash = hash_bytes(hash, sample.data(), sample.size());
+    return true;
+}
+} // namespace
+
+namespace ert {
+
+source_fingerprint
+source_fingerprint::stat_files(const std::vector<std::string> &files,
+                               const std::string &context) {
+    source_fingerprint fingerprint;
+    fingerprint.hash =
+        hash_bytes(hash_bytes_seed, context.data(), context.size());
+    for (const auto &file : files) {
+        std::error_code ec;
+        auto size = fs::file_size(file, ec);
+        auto mtime = fs::last_write_time(file, ec);
+        if (ec) {
+            fingerprint.hash = (fingerprint.hash ^ 1) * hash_prime;
+            continue;
+        }
+
+        fingerprint.size += size;
+        fingerprint.mtime = std::max<int64_t>(
+            fingerprint.mtime, mtime.time_since_epoch().count());
+    }
+    return fingerprint;
+}
+
+void source_fingerprint::hash_samples(const std::vector<std::string> &files) {
+    for (const auto &file : files) {
+        if (!hash_file_samples(file, sample_size, hash))
+            hash = (hash ^ 1) * hash_prime;
+    }
+}
+
+source_fingerprint
+source_fingerprint::of_files(const std::vector<std::string> &files,
+                             const std::string &context) {
+    auto fingerprint = stat_files(files, context);
+    fingerprint.hash_samples(files);
+    return fingerprint;
+}
+
+result_files::result_files(std::vector<std::string> files,
+                           const std::string &context)
+    : files(std::move(files)),
+      stat(source_fingerprint::stat_files(this->files, context)) {}
+
+source_fingerprint result_files::fingerprint() const {
+    auto fingerprint = stat;
+    fingerprint.hash_samples(files);
+    return fingerprint;
+}
+
+bool load_sources::unchanged(const std::string &key,
+                             const source_fingerprint &fingerprint) const {
+    auto iter = sources.find(key);
+    return iter != sources.end() && iter->second == fingerprint;
+}
+
+bool load_sources::unchanged(const std::string &key,
+                             const result_files &files) const {
+    auto iter = sources.find(key);
+    if (iter == sources.end() || iter->second.size != files.stat.size ||
+        iter->second.mtime != files.stat.mtime)
+        return false;
+
+    return iter->second == files.fingerprint();
+}
+
+void load_sources::set(const std::string &key,
+                       const source_fingerprint &fingerprint) {
+    sources[key] = fingerprint;
+}
+
+void load_sources::set(const std::string &key, const result_files &files) {
+    sources[key] = files.fingerprint();
+}
+
+void load_sources::erase(const std::string &key) { sources.erase(key); }
+
+void load_sources::fwrite(buffer_type *buffer) const {
+    buffer_fwrite_int(buffer, LOAD_SOURCES_ID);
+    buffer_fwrite_int(buffer, static_cast<int>(sources.size()));
+    for (const auto &[key, fingerprint] : sources) {
+        buffer_fwrite_int(buffer, static_cast<int>(key.size()));
+        buffer_fwrite(buffer, key.data(), 1, key.size());
+        buffer_fwrite(buffer, &fingerprint.size, sizeof fingerprint.size, 1);
+        buffer_fwrite(buffer, &fingerprint.mtime, sizeof fingerprint.mtime,
+                      1);
+        buffer_fwrite(buffer, &fingerprint.hash, sizeof fingerprint.hash, 1);
+    }
+}
+
+void load_sources::fread(buffer_type *buffer) {
+    if (buffer_fread_int(buffer) != LOAD_SOURCES_ID)
+        util_abort("%s: buffer does not contain load sources\n", __func__);
+
+    sources.clear();
+    int num_sources = buffer_fread_int(buffer);
+    for (int i = 0; i < num_sources; i++) {
+        std::string key(buffer_fread_int(buffer), '\0');
+        buffer_fread(buffer, key.data(), 1, key.size());
+
+        source_fingerprint fingerprint;
+        buffer_fread(buffer, &fingerprint.size, sizeof fingerprint.size, 1);
+        buffer_fread(buffer, &fingerprint.mtime, sizeof fingerprint.mtime, 1);
+        buffer_fread(buffer, &fingerprint.hash, sizeof fingerprint.hash, 1);
+        sources.emplace(std::move(key), fingerprint);
+    }
+}
+
+} // namespace ert
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <pthread.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <Eigen/Dense>
 #include <algorithm>
@@ -119,6 +120,16 @@ meas_block_type *meas_block_alloc(const char *obs_key,
     return meas_block;
 }
 
+meas_block_type *meas_block_alloc_copy(const meas_block_type *src) {
+    meas_block_type *meas_block =
+        meas_block_alloc(src->obs_key, src->ens_mask, src->obs_size);
+    memcpy(meas_block->data, src->data,
+           src->data_size * sizeof *meas_block->data);
+    memcpy(meas_block->active, src->active,
+           src->obs_size * sizeof *meas_block->active);
+    return meas_block;
+}
+
 void meas_block_free(meas_block_type *meas_block) {
     free(meas_block->obs_key);
     free(meas_block->data);
@@ -207,6 +218,43 @@ void meas_block_iset(meas_block_type *meas_block, int iens, int iobs,
     }
 }
 
+/**
+   Gathers data[data_index[i]] into observation row obs_index[i] of
+   realization iens for all i in one pass; this is equivalent to calling
+   meas_block_iset() for each element, but the realization lookup is only
+   done once and the inner loop is a plain strided gather.
+*/
+template <typename T>
+void meas_block_iset_gather(meas_block_type *meas_block, int iens,
+                            const std::vector<int> &obs_index,
+                            const std::vector<int> &data_index, const T *data) {
+    meas_block_assert_iens_active(meas_block, iens);
+    {
+        int active_iens = int_vector_iget(meas_block->index_map, iens);
+        double *ens_data =
+            meas_block->data + active_iens * meas_block->ens_stride;
+        const int obs_stride = meas_block->obs_stride;
+        const size_t size = obs_index.size();
+
+        for (size_t i = 0; i < size; i++)
+            ens_data[obs_index[i] * obs_stride] = data[data_index[i]];
+
+        for (size_t i = 0; i < size; i++)
+            meas_block->active[obs_index[i]] = true;
+
+        meas_block->stat_calculated = false;
+    }
+}
+
+template void meas_block_iset_gather<float>(meas_block_type *, int,
+                                            const std::vector<int> &,
+                                            const std::vector<int> &,
+                                            const float *);
+template void meas_block_iset_gather<double>(meas_block_type *, int,
+                                             const std::vector<int> &,
+                                             const std::vector<int> &,
+                                             const double *);
+
 double meas_block_iget(const meas_block_type *meas_block, int iens, int iobs) {
     meas_block_assert_iens_active(meas_block, iens);
     {
@@ -319,6 +367,25 @@ meas_block_type *meas_data_add_block(meas_data_type *matrix,
     return (meas_block_type *)vector_get_last(matrix->data);
 }
 
+/**
+  Adds a block with the same key, measurements and active elements as @src;
+  the ensemble mask of @src must equal the mask of the meas_data instance.
+*/
+void meas_data_add_block_copy(meas_data_type *matrix, int report_step,
+                              const meas_block_type *src) {
+    if (src->ens_mask != matrix->ens_mask)
+        util_abort("%s: ensemble mask mismatch for block:%s \n", __func__,
+                   src->obs_key);
+
+    meas_block_type *meas_block =
+        meas_data_add_block(matrix, src->obs_key, report_step, src->obs_size);
+    memcpy(meas_block->data, src->data,
+           src->data_size * sizeof *meas_block->data);
+    memcpy(meas_block->active, src->active,
+           src->obs_size * sizeof *meas_block->active);
+    meas_block->stat_calculated = false;
+}
+
 /*
   Observe that the key should compare with the keys created by meas_data_alloc_key().
 */
@@ -0,0 +1,77 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'measurement_cache.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <ert/enkf/measurement_cache.hpp>
+
+namespace ert {
+
+size_t measurement::byte_size() const {
+    size_t size = 0;
+    for (const auto &[report_step, meas_block] : blocks)
+        size += sizeof(double) *
+                meas_block_get_total_obs_size(meas_block.get()) *
+                (meas_block_get_active_ens_size(meas_block.get()) + 2);
+    return size;
+}
+
+std::shared_ptr<const measurement>
+measurement_cache::get(const std::string &obs_key, long obs_version,
+                       long generation,
+                       const std::vector<int> &ens_active_list) const {
+    std::lock_guard<std::mutex> guard(mutex);
+    auto iter = entries.find(obs_key);
+    if (iter == entries.end())
+        return nullptr;
+
+    const auto &entry = iter->second;
+    if (entry.obs_version != obs_version || entry.generation != generation ||
+        entry.ens_active_list != ens_active_list)
+        return nullptr;
+
+    return entry.value;
+}
+
+void measurement_cache::put(const std::string &obs_key, long obs_version,
+                            long generation,
+                            const std::vector<int> &ens_active_list,
+                            std::shared_ptr<const measurement> value) {
+    std::lock_guard<std::mutex> guard(mutex);
+    for (auto iter = entries.begin(); iter != entries.end();) {
+        if (iter->first == obs_key || iter->second.generation != generation) {
+            total_bytes -= iter->second.value->byte_size();
+            iter = entries.erase(iter);
+        } else
+            ++iter;
+    }
+
+    size_t value_bytes = value->byte_size();
+    if (total_bytes + value_bytes > max_bytes)
+        return;
+
+    total_bytes += value_bytes;
+    entries[obs_key] = {obs_version, generation, ens_active_list,
+                        std::move(value)};
+}
+
+void measurement_cache::clear() {
+    std::lock_guard<std::mutex> guard(mutex);
+    entries.clear();
+    total_bytes = 0;
+}
+
+} // namespace ert
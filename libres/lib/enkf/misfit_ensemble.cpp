@@ -16,9 +16,17 @@
    for more details.
 */
 
+#include <algorithm>
+#include <future>
 #include <stdio.h>
 #include <stdlib.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
+#include <Eigen/Dense>
+
+#include <ert/util/bool_vector.h>
 #include <ert/util/hash.h>
 #include <ert/util/util.h>
 #include <ert/util/vector.h>
@@ -33,24 +41,64 @@
 struct misfit_ensemble_struct {
     UTIL_TYPE_ID_DECLARATION;
     bool initialized;
+    /** Whether the content differs from what was last written to, or read
+     * from, disk. */
+    bool modified;
     int history_length;
     /** Vector of misfit_member_type instances - one for each ensemble member. */
     vector_type *ensemble;
 };
 
-static double **__2d_malloc(int rows, int columns) {
-    double **d = (double **)util_calloc(rows, sizeof *d);
-    for (int i = 0; i < rows; i++)
-        d[i] = (double *)util_calloc(columns, sizeof *d[i]);
-    return d;
-}
+namespace {
+/**
+   The chi2 values for one observation key; chi2(step, iens) is stored in one
+   contiguous block.
+*/
+struct misfit_obs_chi2 {
+    const char *obs_key;
+    Eigen::MatrixXd chi2;
+    std::vector<bool> valid;
+};
 
-static void __2d_free(double **d, int rows) {
-    for (int i = 0; i < rows; i++)
-        free(d[i]);
-    free(d);
+/**
+   Evaluates the chi2 for a group of observation keys which all observe the
+   same config node. Loading a node from storage can update state in the
+   shared config node (e.g. the GEN_DATA active mask), therefore observation
+   keys observing the same config node must be evaluated sequentially.
+*/
+std::vector<misfit_obs_chi2>
+misfit_ensemble_eval_group(const enkf_obs_type *enkf_obs, enkf_fs_type *fs,
+                           const std::vector<const char *> &obs_keys,
+                           int ens_size, int history_length) {
+    std::vector<misfit_obs_chi2> group;
+    bool_vector_type *iens_valid = bool_vector_alloc(ens_size, true);
+    for (const char *obs_key : obs_keys) {
+        obs_vector_type *obs_vector = enkf_obs_get_vector(enkf_obs, obs_key);
+        misfit_obs_chi2 result{obs_key,
+                               Eigen::MatrixXd(history_length + 1, ens_size),
+                               std::vector<bool>(ens_size)};
+
+        bool_vector_set_all(iens_valid, true);
+        obs_vector_ensemble_chi2(obs_vector, fs, iens_valid, 0, history_length,
+                                 0, ens_size, result.chi2);
+        for (int iens = 0; iens < ens_size; iens++)
+            result.valid[iens] = bool_vector_iget(iens_valid, iens);
+
+        group.push_back(std::move(result));
+    }
+    bool_vector_free(iens_valid);
+    return group;
 }
+} // namespace
 
+/**
+   The chi2 evaluation for the different observation keys is independent,
+   and is run in parallel. The observation keys are grouped by the config
+   node they observe, and the groups are evaluated in batches of at most
+   #cores concurrent tasks. The results of a batch are internalized in a
+   fixed order before the next batch is started, so the memory usage is
+   bounded and the result does not depend on thread scheduling.
+*/
 void misfit_ensemble_initialize(misfit_ensemble_type *misfit_ensemble,
                                 const ensemble_config_type *ensemble_config,
                                 const enkf_obs_type *enkf_obs, enkf_fs_type *fs,
@@ -58,45 +106,72 @@ void misfit_ensemble_initialize(misfit_ensemble_type *misfit_ensemble,
                                 bool force_init) {
 
     if (force_init || !misfit_ensemble->initialized) {
-        misfit_ensemble_clear(misfit_ensemble);
-
-        double **chi2_work = __2d_malloc(history_length + 1, ens_size);
-        bool_vector_type *iens_valid = bool_vector_alloc(ens_size, true);
-
-        hash_iter_type *obs_iter = enkf_obs_alloc_iter(enkf_obs);
-        const char *obs_key = hash_iter_get_next_key(obs_iter);
-
-        misfit_ensemble->history_length = history_length;
-        misfit_ensemble_set_ens_size(misfit_ensemble, ens_size);
-
-        while (obs_key != NULL) {
-            obs_vector_type *obs_vector =
-                enkf_obs_get_vector(enkf_obs, obs_key);
+        std::vector<std::vector<const char *>> groups;
+        {
+            std::unordered_map<const enkf_config_node_type *, size_t>
+                group_index;
+            hash_iter_type *obs_iter = enkf_obs_alloc_iter(enkf_obs);
+            const char *obs_key = hash_iter_get_next_key(obs_iter);
+            while (obs_key != NULL) {
+                const enkf_config_node_type *config_node =
+                    obs_vector_get_config_node(
+                        enkf_obs_get_vector(enkf_obs, obs_key));
+                auto [iter, inserted] =
+                    group_index.emplace(config_node, groups.size());
+                if (inserted)
+                    groups.emplace_back();
+                groups[iter->second].push_back(obs_key);
+                obs_key = hash_iter_get_next_key(obs_iter);
+            }
+            hash_iter_free(obs_iter);
+        }
 
-            bool_vector_reset(iens_valid);
-            bool_vector_iset(iens_valid, ens_size - 1, true);
-            obs_vector_ensemble_chi2(obs_vector, fs, iens_valid, 0,
-                                     misfit_ensemble->history_length, 0,
-                                     ens_size, chi2_work);
+        vector_type *ensemble = vector_alloc_new();
+        for (int iens = 0; iens < ens_size; iens++)
+            vector_append_owned_ref(ensemble, misfit_member_alloc(iens),
+                                    misfit_member_free__);
 
-            // Internalizing the results from the chi2_work table into the
+        const size_t batch_size =
+            std::max(1U, std::thread::hardware_concurrency());
+        for (size_t batch_start = 0; batch_start < groups.size();
+             batch_start += batch_size) {
+            size_t batch_end =
+                std::min(groups.size(), batch_start + batch_size);
+            std::vector<std::future<std::vector<misfit_obs_chi2>>> futures;
+            for (size_t igroup = batch_start; igroup < batch_end; igroup++)
+                futures.push_back(std::async(
+                    std::launch::async, misfit_ensemble_eval_group, enkf_obs,
+                    fs, std::cref(groups[igroup]), ens_size, history_length));
+
+            // Internalizing the results from the chi2 tables into the
             // misfit structure.
-            for (int iens = 0; iens < ens_size; iens++) {
-                misfit_member_type *node =
-                    misfit_ensemble_iget_member(misfit_ensemble, iens);
-                if (bool_vector_iget(iens_valid, iens))
-                    misfit_member_update(node, obs_key,
-                                         misfit_ensemble->history_length, iens,
-                                         (const double **)chi2_work);
+            for (auto &fut : futures) {
+                for (const auto &result : fut.get()) {
+                    for (int iens = 0; iens < ens_size; iens++) {
+                        if (result.valid[iens])
+                            misfit_member_update(
+                                (misfit_member_type *)vector_iget(ensemble,
+                                                                  iens),
+                                result.obs_key, history_length, iens,
+                                result.chi2);
+                    }
+                }
             }
-            obs_key = hash_iter_get_next_key(obs_iter);
         }
 
-        bool_vector_free(iens_valid);
-        hash_iter_free(obs_iter);
+        bool modified = misfit_ensemble->history_length != history_length ||
+                        vector_get_size(misfit_ensemble->ensemble) != ens_size;
+        for (int iens = 0; !modified && iens < ens_size; iens++)
+            modified = !misfit_member_equal(
+                misfit_ensemble_iget_member(misfit_ensemble, iens),
+                (const misfit_member_type *)vector_iget_const(ensemble, iens));
 
-        __2d_free(chi2_work, misfit_ensemble->history_length + 1);
+        vector_free(misfit_ensemble->ensemble);
+        misfit_ensemble->ensemble = ensemble;
+        misfit_ensemble->history_length = history_length;
         misfit_ensemble->initialized = true;
+        if (modified)
+            misfit_ensemble->modified = true;
     }
 }
 
@@ -158,12 +233,14 @@ void misfit_ensemble_fread(misfit_ensemble_type *misfit_ensemble,
             }
         }
     }
+    misfit_ensemble->modified = false;
 }
 
 misfit_ensemble_type *misfit_ensemble_alloc() {
     auto table = new misfit_ensemble_type();
 
     table->initialized = false;
+    table->modified = true;
     table->ensemble = vector_alloc_new();
 
     return table;
@@ -188,6 +265,18 @@ bool misfit_ensemble_initialized(const misfit_ensemble_type *misfit_ensemble) {
     return misfit_ensemble->initialized;
 }
 
+bool misfit_ensemble_modified(const misfit_ensemble_type *misfit_ensemble) {
+    return misfit_ensemble->modified;
+}
+
+/**
+   Should be called when the content has been persisted with
+   misfit_ensemble_fwrite().
+*/
+void misfit_ensemble_set_saved(misfit_ensemble_type *misfit_ensemble) {
+    misfit_ensemble->modified = false;
+}
+
 int misfit_ensemble_get_ens_size(const misfit_ensemble_type *misfit_ensemble) {
     return vector_get_size(misfit_ensemble->ensemble);
 }
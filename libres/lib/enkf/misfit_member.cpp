@@ -80,11 +80,34 @@ bool misfit_member_has_ts(const misfit_member_type *node, const char *obs_key) {
 
 void misfit_member_update(misfit_member_type *node, const char *obs_key,
                           int history_length, int iens,
-                          const double **work_chi2) {
+                          const Eigen::MatrixXd &work_chi2) {
     misfit_ts_type *vector =
         misfit_member_safe_get_vector(node, obs_key, history_length);
     for (int step = 0; step <= history_length; step++)
-        misfit_ts_iset(vector, step, work_chi2[step][iens]);
+        misfit_ts_iset(vector, step, work_chi2(step, iens));
+}
+
+/**
+   Will return true if the two members have misfit time series for exactly
+   the same observation keys, with identical values.
+*/
+bool misfit_member_equal(const misfit_member_type *node1,
+                         const misfit_member_type *node2) {
+    if (hash_get_size(node1->obs) != hash_get_size(node2->obs))
+        return false;
+
+    bool equal = true;
+    hash_iter_type *obs_iter = hash_iter_alloc(node1->obs);
+    while (equal && !hash_iter_is_complete(obs_iter)) {
+        const char *key = hash_iter_get_next_key(obs_iter);
+        if (hash_has_key(node2->obs, key))
+            equal = misfit_ts_equal(misfit_member_get_ts(node1, key),
+                                    misfit_member_get_ts(node2, key));
+        else
+            equal = false;
+    }
+    hash_iter_free(obs_iter);
+    return equal;
 }
 
 void misfit_member_fwrite(const misfit_member_type *node, FILE *stream) {
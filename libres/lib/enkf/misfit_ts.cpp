@@ -74,6 +74,10 @@ void misfit_ts_iset(misfit_ts_type *vector, int time_index, double value) {
     double_vector_iset(vector->data, time_index, value);
 }
 
+bool misfit_ts_equal(const misfit_ts_type *ts1, const misfit_ts_type *ts2) {
+    return double_vector_equal(ts1->data, ts2->data);
+}
+
 /* Step2 is inclusive */
 double misfit_ts_eval(const misfit_ts_type *vector,
                       const int_vector_type *steps) {
@@ -21,6 +21,7 @@
 */
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <stdlib.h>
 #include <string.h>
@@ -71,8 +72,16 @@ struct obs_vector_struct {
      * nodes[ ] != NULL) */
     int num_active;
     std::vector<int> step_list;
+    /** Unique among all obs_vector instances, and changed whenever a node is
+     * installed; identifies the content for cached measurements. */
+    long version;
 };
 
+static long obs_vector_next_version() {
+    static std::atomic<long> version{0};
+    return ++version;
+}
+
 UTIL_IS_INSTANCE_FUNCTION(obs_vector, OBS_VECTOR_TYPE_ID)
 UTIL_SAFE_CAST_FUNCTION(obs_vector, OBS_VECTOR_TYPE_ID)
 
@@ -163,6 +172,7 @@ obs_vector_type *obs_vector_alloc(obs_impl_type obs_type, const char *obs_key,
     auto vector = new obs_vector_type;
 
     UTIL_TYPE_ID_INIT(vector, OBS_VECTOR_TYPE_ID);
+    vector->version = obs_vector_next_version();
     vector->freef = NULL;
     vector->measure = NULL;
     vector->get_obs = NULL;
@@ -275,6 +285,7 @@ void obs_vector_install_node(obs_vector_type *obs_vector, int index,
 
         vector_iset_owned_ref(obs_vector->nodes, index, node,
                               obs_vector->freef);
+        obs_vector->version = obs_vector_next_version();
     }
 }
 
@@ -296,6 +307,10 @@ int obs_vector_get_num_active(const obs_vector_type *vector) {
     return vector->num_active;
 }
 
+long obs_vector_get_version(const obs_vector_type *vector) {
+    return vector->version;
+}
+
 const std::vector<int> &
 obs_vector_get_step_list(const obs_vector_type *vector) {
     return vector->step_list;
@@ -880,30 +895,6 @@ void obs_vector_measure(const obs_vector_type *obs_vector, enkf_fs_type *fs,
     }
 }
 
-static bool
-obs_vector_has_data_at_report_step(const obs_vector_type *obs_vector,
-                                   const bool_vector_type *active_mask,
-                                   enkf_fs_type *fs, int report_step) {
-    void *obs_node = (void *)vector_iget(obs_vector->nodes, report_step);
-    if (obs_node) {
-        node_id_type node_id = {.report_step = report_step};
-        for (int iens = 0; iens < bool_vector_size(active_mask); iens++) {
-            if (bool_vector_iget(active_mask, iens)) {
-                node_id.iens = iens;
-                if (!enkf_config_node_has_node(obs_vector->config_node, fs,
-                                               node_id))
-                    return false;
-            }
-        }
-    }
-
-    /*
-     Will return true unconditionally if we do not have observation data at this report step;
-     or alternatively if the active_mask is all false.
-  */
-    return true;
-}
-
 /**
   The has_vector_data() function will only check that we have a vector
   stored, and not the actual length of the vector. This means we can
@@ -914,36 +905,49 @@ obs_vector_has_data_at_report_step(const obs_vector_type *obs_vector,
   requires changes in the enkf_node api for vector storage.
 */
 static bool obs_vector_has_vector_data(const obs_vector_type *obs_vector,
-                                       const bool_vector_type *active_mask,
+                                       const std::vector<int> &iens_list,
                                        enkf_fs_type *fs) {
-    int vec_size = bool_vector_size(active_mask);
-
-    for (int iens = 0; iens < vec_size; iens++) {
-        const enkf_config_node_type *data_config = obs_vector->config_node;
-        if (bool_vector_iget(active_mask, iens)) {
-            if (!enkf_config_node_has_vector(data_config, fs, iens)) {
-                return false;
-            }
-        }
-    }
-
-    return true;
+    std::vector<bool> has_vector =
+        enkf_config_node_has_vectors(obs_vector->config_node, fs, iens_list);
+    return std::all_of(has_vector.begin(), has_vector.end(),
+                       [](bool has) { return has; });
 }
 
+/**
+   Checks that data is stored for all the active realizations at all the
+   report steps where the observation is active. Will return true
+   unconditionally if the active_mask is all false.
+
+   All the (report_step, iens) combinations are checked with one bulk
+   query to the storage.
+*/
 bool obs_vector_has_data(const obs_vector_type *obs_vector,
                          const bool_vector_type *active_mask,
                          enkf_fs_type *fs) {
+    std::vector<int> iens_list;
+    for (int iens = 0; iens < bool_vector_size(active_mask); iens++) {
+        if (bool_vector_iget(active_mask, iens))
+            iens_list.push_back(iens);
+    }
+
     const enkf_config_node_type *data_config = obs_vector->config_node;
     if (enkf_config_node_vector_storage(data_config))
-        return obs_vector_has_vector_data(obs_vector, active_mask, fs);
+        return obs_vector_has_vector_data(obs_vector, iens_list, fs);
 
+    std::vector<node_id_type> node_ids;
     int vec_size = vector_get_size(obs_vector->nodes);
     for (int report_step = 0; report_step < vec_size; report_step++) {
-        if (!obs_vector_has_data_at_report_step(obs_vector, active_mask, fs,
-                                                report_step))
-            return false;
+        if (vector_iget(obs_vector->nodes, report_step) == NULL)
+            continue;
+
+        for (int iens : iens_list)
+            node_ids.push_back({.report_step = report_step, .iens = iens});
     }
-    return true;
+
+    std::vector<bool> has_node =
+        enkf_config_node_has_nodes(data_config, fs, node_ids);
+    return std::all_of(has_node.begin(), has_node.end(),
+                       [](bool has) { return has; });
 }
 
 /**
@@ -974,44 +978,51 @@ static double obs_vector_chi2__(const obs_vector_type *obs_vector,
 
 /**
    This function will evaluate the chi2 for the ensemble members
-   [iens1,iens2) and report steps [step1,step2).
+   [iens1,iens2) and report steps [step1,step2].
 
-   Observe that the chi2 pointer is assumed to be allocated for the
-   complete ensemble, altough this function only operates on part of
-   it.
+   The chi2 matrix is indexed as chi2(step, iens), and is assumed to be
+   allocated for the complete ensemble, altough this function only operates
+   on part of it. The realizations are visited in the outer loop, so that
+   nodes with vector storage (i.e. summary) are loaded from storage only once
+   per realization.
 
    This will not work for container observations .....
 */
 void obs_vector_ensemble_chi2(const obs_vector_type *obs_vector,
                               enkf_fs_type *fs, bool_vector_type *valid,
                               int step1, int step2, int iens1, int iens2,
-                              double **chi2) {
+                              Eigen::MatrixXd &chi2) {
 
-    int step;
     enkf_node_type *enkf_node = enkf_node_alloc(obs_vector->config_node);
+    bool vector_storage = enkf_node_vector_storage(enkf_node);
     node_id_type node_id;
-    for (step = step1; step <= step2; step++) {
-        int iens;
-        node_id.report_step = step;
-        {
+    for (int iens = iens1; iens < iens2; iens++) {
+        bool has_vector = false;
+        node_id.iens = iens;
+        if (vector_storage)
+            has_vector = enkf_node_try_load_vector(enkf_node, fs, iens);
+
+        for (int step = step1; step <= step2; step++) {
             void *obs_node = (void *)vector_iget(obs_vector->nodes, step);
 
-            if (obs_node == NULL) {
-                for (iens = iens1; iens < iens2; iens++)
-                    chi2[step][iens] = 0;
-            } else {
-                for (iens = iens1; iens < iens2; iens++) {
-                    node_id.iens = iens;
-                    if (enkf_node_try_load(enkf_node, fs, node_id))
-                        chi2[step][iens] = obs_vector_chi2__(
-                            obs_vector, step, enkf_node, node_id);
-                    else {
-                        chi2[step][iens] = 0;
-                        // Missing data - this member will be marked as invalid in the misfit calculations.
-                        bool_vector_iset(valid, iens, false);
-                    }
-                }
-            }
+            chi2(step, iens) = 0;
+            if (obs_node == NULL)
+                continue;
+
+            node_id.report_step = step;
+            bool has_data;
+            if (vector_storage)
+                has_data =
+                    has_vector && enkf_node_vector_has_data(enkf_node, step);
+            else
+                has_data = enkf_node_try_load(enkf_node, fs, node_id);
+
+            if (has_data)
+                chi2(step, iens) =
+                    obs_vector_chi2__(obs_vector, step, enkf_node, node_id);
+            else
+                // Missing data - this member will be marked as invalid in the misfit calculations.
+                bool_vector_iset(valid, iens, false);
         }
     }
     enkf_node_free(enkf_node);
@@ -1,21 +1,77 @@
 #include <ert/enkf/summary_key_matcher.hpp>
 
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include <stdlib.h>
 
 #include <ert/util/hash.h>
 
 #define SUMMARY_KEY_MATCHER_TYPE_ID 700672137
 
+namespace {
+/**
+   The patterns of a matcher compiled for lookup: patterns without wildcards
+   are looked up directly, and the glob patterns are grouped by their literal
+   prefix, so that only the globs whose prefix is a prefix of a key have to be
+   matched against it.
+*/
+struct compiled_patterns {
+    std::unordered_set<std::string> exact;
+    std::unordered_map<std::string, std::vector<std::string>> globs;
+    /** The distinct lengths of the prefixes in globs, in increasing order. */
+    std::vector<size_t> prefix_lengths;
+
+    bool match(const char *summary_key) const {
+        if (summary_key[0] == '\0')
+            return false;
+
+        const std::string key = summary_key;
+        if (exact.count(key) > 0)
+            return true;
+
+        for (size_t length : prefix_lengths) {
+            if (length > key.size())
+                break;
+
+            auto iter = globs.find(key.substr(0, length));
+            if (iter == globs.end())
+                continue;
+
+            for (const auto &pattern : iter->second)
+                if (util_fnmatch(pattern.c_str(), summary_key) == 0)
+                    return true;
+        }
+        return false;
+    }
+};
+} // namespace
+
 struct summary_key_matcher_struct {
     UTIL_TYPE_ID_DECLARATION;
     hash_type *key_set;
+
+    /** Compiled from key_set when needed; reset when a key is added. */
+    mutable std::shared_ptr<const compiled_patterns> patterns;
+    /** The results of summary_key_matcher_match_summary_keys() for the last
+     * lists of keys it was called with, most recent first. */
+    mutable std::deque<std::pair<std::vector<std::string>,
+                                 std::shared_ptr<const std::vector<bool>>>>
+        matched;
+    mutable std::mutex mutex;
 };
 
 UTIL_IS_INSTANCE_FUNCTION(summary_key_matcher, SUMMARY_KEY_MATCHER_TYPE_ID)
 
 summary_key_matcher_type *summary_key_matcher_alloc() {
-    summary_key_matcher_type *matcher =
-        (summary_key_matcher_type *)util_malloc(sizeof *matcher);
+    summary_key_matcher_type *matcher = new summary_key_matcher_type();
     UTIL_TYPE_ID_INIT(matcher, SUMMARY_KEY_MATCHER_TYPE_ID);
     matcher->key_set = hash_alloc();
     return matcher;
@@ -23,7 +79,7 @@ summary_key_matcher_type *summary_key_matcher_alloc() {
 
 void summary_key_matcher_free(summary_key_matcher_type *matcher) {
     hash_free(matcher->key_set);
-    free(matcher);
+    delete matcher;
 }
 
 int summary_key_matcher_get_size(const summary_key_matcher_type *matcher) {
@@ -35,26 +91,85 @@ void summary_key_matcher_add_summary_key(summary_key_matcher_type *matcher,
     if (!hash_has_key(matcher->key_set, summary_key)) {
         hash_insert_int(matcher->key_set, summary_key,
                         !util_string_has_wildcard(summary_key));
+
+        std::lock_guard<std::mutex> guard(matcher->mutex);
+        matcher->patterns.reset();
+        matcher->matched.clear();
     }
 }
 
+static std::shared_ptr<const compiled_patterns>
+summary_key_matcher_get_patterns(const summary_key_matcher_type *matcher) {
+    std::lock_guard<std::mutex> guard(matcher->mutex);
+    if (matcher->patterns)
+        return matcher->patterns;
+
+    auto patterns = std::make_shared<compiled_patterns>();
+    stringlist_type *keys = hash_alloc_stringlist(matcher->key_set);
+    for (int i = 0; i < stringlist_get_size(keys); i++) {
+        const std::string pattern = stringlist_iget(keys, i);
+        size_t prefix_length = pattern.find_first_of("*?[\\");
+        if (prefix_length == std::string::npos)
+            patterns->exact.insert(pattern);
+        else
+            patterns->globs[pattern.substr(0, prefix_length)].push_back(
+                pattern);
+    }
+    stringlist_free(keys);
+
+    for (const auto &[prefix, globs] : patterns->globs)
+        patterns->prefix_lengths.push_back(prefix.size());
+    std::sort(patterns->prefix_lengths.begin(), patterns->prefix_lengths.end());
+    patterns->prefix_lengths.erase(
+        std::unique(patterns->prefix_lengths.begin(),
+                    patterns->prefix_lengths.end()),
+        patterns->prefix_lengths.end());
+
+    matcher->patterns = patterns;
+    return matcher->patterns;
+}
+
 bool summary_key_matcher_match_summary_key(
     const summary_key_matcher_type *matcher, const char *summary_key) {
-    stringlist_type *keys = hash_alloc_stringlist(matcher->key_set);
-    bool has_key = false;
+    if (!summary_key)
+        return false;
 
-    for (int i = 0; i < stringlist_get_size(keys); i++) {
-        const char *pattern = stringlist_iget(keys, i);
-        if (summary_key)
-            if (util_fnmatch(pattern, summary_key) == 0) {
-                has_key = true;
-                break;
-            }
+    return summary_key_matcher_get_patterns(matcher)->match(summary_key);
+}
+
+/**
+   Matches all of summary_keys, typically the keys of a SMSPEC file, in one
+   go; element i of the result tells whether summary_keys[i] is matched. An
+   empty key, which stands for a node without a key, is never matched, not
+   even by "*". The results for the last two lists of keys are kept, since
+   all the realizations of a case normally have the same summary keys; they
+   are matched both when the SMSPEC file is read and for the vectors which
+   were read from it.
+*/
+std::shared_ptr<const std::vector<bool>>
+summary_key_matcher_match_summary_keys(
+    const summary_key_matcher_type *matcher,
+    const std::vector<std::string> &summary_keys) {
+    const size_t max_matched = 2;
+    {
+        std::lock_guard<std::mutex> guard(matcher->mutex);
+        for (const auto &[keys, matched] : matcher->matched)
+            if (keys == summary_keys)
+                return matched;
     }
 
-    stringlist_free(keys);
+    auto patterns = summary_key_matcher_get_patterns(matcher);
+    auto matched = std::make_shared<std::vector<bool>>(summary_keys.size());
+    for (size_t i = 0; i < summary_keys.size(); i++)
+        (*matched)[i] = patterns->match(summary_keys[i].c_str());
 
-    return has_key;
+    std::lock_guard<std::mutex> guard(matcher->mutex);
+    if (matcher->patterns == patterns) {
+        matcher->matched.emplace_front(summary_keys, matched);
+        if (matcher->matched.size() > max_matched)
+            matcher->matched.pop_back();
+    }
+    return matched;
 }
 
 stringlist_type *
@@ -0,0 +1,340 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'summary_reader.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <unordered_set>
+
+#include <ert/ecl/ecl_smspec.hpp>
+#include <ert/ecl/ecl_sum.hpp>
+#include <ert/ecl/ecl_sum_tstep.hpp>
+#include <ert/ecl/smspec_node.hpp>
+
+#include <ert/enkf/summary_reader.hpp>
+#include <ert/logging.hpp>
+
+static auto logger = ert::get_logger("enkf.summary_reader");
+
+namespace {
+
+uint32_t read_big_endian(const unsigned char *bytes) {
+    return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) |
+           (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+}
+
+/**
+ Reads the keywords of an unformatted, big endian ECLIPSE file. The data of
+ a keyword is stored in Fortran records of at most 1000 elements, or 105
+ elements for the character types, each enclosed by its byte length.
+*/
+class keyword_reader {
+public:
+    explicit keyword_reader(const char *filename)
+        : stream(fopen(filename, "rb"), fclose) {}
+
+    bool is_open() const { return stream != nullptr; }
+    /** Whether the last read_header() stopped at the end of the file. */
+    bool at_end() const { return end; }
+
+    /** Reads the next keyword header; returns false at the end of the file
+     * or on error. */
+    bool read_header() {
+        unsigned char header[24];
+        size_t header_size = fread(header, 1, sizeof header, stream.get());
+        if (header_size == 0 && feof(stream.get()))
+            end = true;
+        if (header_size != sizeof header)
+            return false;
+        if (read_big_endian(header) != 16 ||
+            read_big_endian(header + 20) != 16)
+            return false;
+
+        name.assign(reinterpret_cast<const char *>(header) + 4, 8);
+        count = static_cast<int32_t>(read_big_endian(header + 12));
+        type.assign(reinterpret_cast<const char *>(header) + 16, 4);
+        return count >= 0;
+    }
+
+    /** Skips the data records of the keyword whose header was read last. */
+    bool skip_data() {
+        size_t remaining;
+        if (!data_size(remaining))
+            return false;
+
+        while (remaining > 0) {
+            size_t record_size;
+            if (!read_marker(record_size) || record_size > remaining ||
+                fseek(stream.get(), record_size, SEEK_CUR) != 0 ||
+                !check_marker(record_size))
+                return false;
+            remaining -= record_size;
+        }
+        return true;
+    }
+
+    /**
+     Reads the values at the sorted indices of the REAL keyword whose header
+     was read last; the value at index[i] is appended to values[i].
+    */
+    bool read_floats(const std::vector<int> &index,
+                     std::vector<std::vector<float>> &values) {
+        if (type != "REAL")
+            return false;
+
+        size_t offset = 0;
+        size_t next = 0;
+        const size_t total = count;
+        while (offset < total) {
+            size_t record_size;
+            if (!read_marker(record_size) || record_size % sizeof(float) != 0)
+                return false;
+
+            const size_t record_count = record_size / sizeof(float);
+            if (record_count == 0 || offset + record_count > total)
+                return false;
+
+            const size_t record_end = offset + record_count;
+            if (next < index.size() && size_t(index[next]) < record_end) {
+                record.resize(record_size);
+                if (fread(record.data(), 1, record_size, stream.get()) !=
+                    record_size)
+                    return false;
+
+                while (next < index.size() &&
+                       size_t(index[next]) < record_end) {
+                    uint32_t bits = read_big_endian(
+                        record.data() + (index[next] - offset) * sizeof(float));
+                    float value;
+                    std::memcpy(&value, &bits, sizeof value);
+                    values[next].push_back(value);
+                    next++;
+                }
+            } else if (fseek(stream.get(), record_size, SEEK_CUR) != 0)
+                return false;
+
+            if (!check_marker(record_size))
+                return false;
+            offset += record_count;
+        }
+        return next == index.size();
+    }
+
+    std::string name;
+    std::string type;
+    int count = 0;
+
+private:
+    bool data_size(size_t &size) const {
+        size_t element_size = 4;
+        if (type == "DOUB")
+            element_size = 8;
+        else if (type == "CHAR")
+            element_size = 8;
+        else if (type == "MESS")
+            element_size = 0;
+        else if (type[0] == 'C')
+            element_size = std::atoi(type.c_str() + 1);
+        else if (type != "INTE" && type != "REAL" && type != "LOGI")
+            return false;
+
+        size = element_size * count;
+        return true;
+    }
+
+    bool read_marker(size_t &size) {
+        unsigned char marker[4];
+        if (fread(marker, 1, sizeof marker, stream.get()) != sizeof marker)
+            return false;
+        size = read_big_endian(marker);
+        return true;
+    }
+
+    bool check_marker(size_t expected) {
+        size_t size;
+        return read_marker(size) && size == expected;
+    }
+
+    std::unique_ptr<FILE, decltype(&fclose)> stream;
+    std::vector<unsigned char> record;
+    bool end = false;
+};
+
+} // namespace
+
+namespace ert {
+
+bool fread_summary_columns(const char *filename, int params_size,
+                           const std::vector<int> &params_index,
+                           summary_columns_data &data) {
+    keyword_reader reader(filename);
+    if (!reader.is_open())
+        return false;
+
+    // The columns are read in increasing order, and stored in the order
+    // they were asked for.
+    std::vector<int> order(params_index.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&params_index](int a, int b) {
+        return params_index[a] < params_index[b];
+    });
+    std::vector<int> sorted_index;
+    for (int i : order)
+        sorted_index.push_back(params_index[i]);
+
+    std::vector<std::vector<float>> sorted_values(params_index.size());
+    int report_step = 0;
+    data.report_steps.clear();
+    while (reader.read_header()) {
+        bool ok;
+        if (reader.name == "PARAMS  ") {
+            if (report_step == 0 || reader.count != params_size)
+                return false;
+            ok = reader.read_floats(sorted_index, sorted_values);
+            data.report_steps.push_back(report_step);
+        } else {
+            if (reader.name == "SEQHDR  ")
+                report_step++;
+            ok = reader.skip_data();
+        }
+
+        if (!ok)
+            return false;
+    }
+    if (!reader.at_end())
+        return false;
+
+    data.values.resize(params_index.size());
+    for (size_t i = 0; i < order.size(); i++)
+        data.values[order[i]] = std::move(sorted_values[i]);
+    return true;
+}
+
+} // namespace ert
+
+namespace {
+
+bool is_local_var(const ecl::smspec_node &node) {
+    auto var_type = node.get_var_type();
+    return var_type == ECL_SMSPEC_LOCAL_BLOCK_VAR ||
+           var_type == ECL_SMSPEC_LOCAL_COMPLETION_VAR ||
+           var_type == ECL_SMSPEC_LOCAL_WELL_VAR;
+}
+
+ecl_sum_type *
+summary_reader_alloc_ecl_sum(const char *header_file,
+                             const char *unified_file,
+                             const char *key_join_string,
+                             const ecl_smspec_type *smspec,
+                             const std::vector<const ecl::smspec_node *> &nodes,
+                             bool time_in_days) {
+    std::vector<int> params_index;
+    for (const auto *node : nodes)
+        params_index.push_back(node->get_params_index());
+
+    ert::summary_columns_data data;
+    if (!ert::fread_summary_columns(unified_file,
+                                    ecl_smspec_get_params_size(smspec),
+                                    params_index, data))
+        return NULL;
+
+    std::string ecl_case = header_file;
+    ecl_case = ecl_case.substr(0, ecl_case.find_last_of('.'));
+    const int *grid_dims = ecl_smspec_get_grid_dims(smspec);
+    ecl_sum_type *ecl_sum = ecl_sum_alloc_writer(
+        ecl_case.c_str(), false, true, key_join_string,
+        ecl_smspec_get_start_time(smspec), time_in_days, grid_dims[0],
+        grid_dims[1], grid_dims[2]);
+
+    // nodes[0] is TIME, which the writer has already added.
+    std::vector<const ecl::smspec_node *> added(nodes.size(), nullptr);
+    for (size_t i = 1; i < nodes.size(); i++)
+        added[i] = ecl_sum_add_var(ecl_sum, nodes[i]->get_keyword(),
+                                   nodes[i]->get_wgname(), nodes[i]->get_num(),
+                                   nodes[i]->get_unit(),
+                                   nodes[i]->get_default());
+
+    const double seconds_per_unit = time_in_days ? 86400 : 3600;
+    for (size_t step = 0; step < data.report_steps.size(); step++) {
+        ecl_sum_tstep_type *tstep =
+            ecl_sum_add_tstep(ecl_sum, data.report_steps[step],
+                              data.values[0][step] * seconds_per_unit);
+        for (size_t i = 1; i < nodes.size(); i++)
+            ecl_sum_tstep_set_from_node(tstep, *added[i],
+                                        data.values[i][step]);
+    }
+    return ecl_sum;
+}
+
+} // namespace
+
+ecl_sum_type *
+summary_reader_fread_alloc(const char *header_file, const char *unified_file,
+                           const char *key_join_string,
+                           const summary_key_matcher_type *matcher) {
+    ecl_smspec_type *smspec =
+        ecl_smspec_fread_alloc(header_file, key_join_string, false);
+    if (!smspec)
+        return NULL;
+
+    ecl_sum_type *ecl_sum = NULL;
+    if (ecl_smspec_has_general_var(smspec, "TIME")) {
+        const auto &time_node = ecl_smspec_get_general_var_node(smspec, "TIME");
+        const std::string time_unit = time_node.get_unit();
+
+        std::vector<std::string> keys;
+        keys.reserve(ecl_smspec_num_nodes(smspec));
+        for (int i = 0; i < ecl_smspec_num_nodes(smspec); i++) {
+            const char *key =
+                ecl_smspec_iget_node_w_node_index(smspec, i).get_gen_key1();
+            keys.push_back(key ? key : "");
+        }
+        auto matched = summary_key_matcher_match_summary_keys(matcher, keys);
+
+        bool supported = time_unit == "DAYS" || time_unit == "HOURS";
+        std::vector<const ecl::smspec_node *> nodes{&time_node};
+        std::unordered_set<std::string> selected{"TIME"};
+        for (int i = 0; supported && i < ecl_smspec_num_nodes(smspec); i++) {
+            // The nodes without a key are never selected.
+            if (keys[i].empty() || !(*matched)[i] ||
+                !selected.insert(keys[i]).second)
+                continue;
+
+            const auto &node = ecl_smspec_iget_node_w_node_index(smspec, i);
+            supported = !is_local_var(node);
+            nodes.push_back(&node);
+        }
+
+        if (supported)
+            ecl_sum = summary_reader_alloc_ecl_sum(
+                header_file, unified_file, key_join_string, smspec, nodes,
+                time_unit == "DAYS");
+    }
+
+    if (!ecl_sum)
+        logger->debug("Can not read the selected summary vectors of: {} - "
+                      "the full summary is loaded",
+                      unified_file);
+    ecl_smspec_free(smspec);
+    return ecl_sum;
+}
@@ -0,0 +1,199 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'summary_table.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <algorithm>
+#include <filesystem>
+#include <time.h>
+
+#include <ert/res_util/file_utils.hpp>
+#include <ert/util/stringlist.h>
+#include <ert/util/util.h>
+
+#include <ert/enkf/enkf_types.hpp>
+#include <ert/enkf/summary.hpp>
+#include <ert/enkf/summary_table.hpp>
+
+namespace fs = std::filesystem;
+
+/*
+  A stored record has the layout:
+
+     int    SUMMARY_RECORD_ID
+     int    num_columns
+     int    num_steps
+     char   present[num_columns]
+     float  values[num_columns][num_steps]
+
+  so the values of one column can be read without reading the full record.
+*/
+#define SUMMARY_RECORD_ID 661934
+
+namespace {
+constexpr size_t header_size = 3 * sizeof(int);
+
+size_t present_offset(int column) { return header_size + column; }
+
+size_t column_offset(int num_columns, int num_steps, int column) {
+    return header_size + num_columns +
+           sizeof(float) * static_cast<size_t>(num_steps) * column;
+}
+} // namespace
+
+namespace ert {
+
+int summary_columns::size() const {
+    std::lock_guard<std::mutex> guard(mutex);
+    return static_cast<int>(keys.size());
+}
+
+int summary_columns::get(const std::string &key) const {
+    std::lock_guard<std::mutex> guard(mutex);
+    auto iter = columns.find(key);
+    return iter == columns.end() ? -1 : iter->second;
+}
+
+int summary_columns::add(const std::string &key) {
+    std::lock_guard<std::mutex> guard(mutex);
+    auto [iter, inserted] =
+        columns.emplace(key, static_cast<int>(keys.size()));
+    if (inserted)
+        keys.push_back(key);
+    return iter->second;
+}
+
+void summary_columns::fwrite(const char *filename) const {
+    std::lock_guard<std::mutex> guard(mutex);
+    auto stream = mkdir_fopen(fs::path(filename), "w");
+    if (!stream)
+        util_abort("%s: failed to open: %s for writing \n", __func__,
+                   filename);
+
+    stringlist_type *key_list = stringlist_alloc_new();
+    for (const auto &key : keys)
+        stringlist_append_copy(key_list, key.c_str());
+    stringlist_fwrite(key_list, stream);
+    stringlist_free(key_list);
+    fclose(stream);
+}
+
+bool summary_columns::fread(const char *filename) {
+    std::lock_guard<std::mutex> guard(mutex);
+    keys.clear();
+    columns.clear();
+    if (!fs::exists(filename))
+        return false;
+
+    FILE *stream = util_fopen(filename, "r");
+    stringlist_type *key_list = stringlist_fread_alloc(stream);
+    for (int i = 0; i < stringlist_get_size(key_list); i++) {
+        keys.push_back(stringlist_iget(key_list, i));
+        columns.emplace(keys.back(), i);
+    }
+    stringlist_free(key_list);
+    fclose(stream);
+    return true;
+}
+
+void summary_record::resize(int num_columns, int num_steps) {
+    num_columns = std::max(num_columns, this->num_columns());
+    num_steps = std::max(num_steps, steps);
+    if (num_columns == this->num_columns() && num_steps == steps)
+        return;
+
+    const float undefined = summary_undefined_value();
+    std::vector<float> new_data(static_cast<size_t>(num_columns) * num_steps,
+                                undefined);
+    for (int column = 0; column < this->num_columns(); column++)
+        std::copy_n(data.begin() + static_cast<size_t>(column) * steps, steps,
+                    new_data.begin() + static_cast<size_t>(column) * num_steps);
+
+    data.swap(new_data);
+    present.resize(num_columns, 0);
+    steps = num_steps;
+}
+
+bool summary_record::has_column(int column) const {
+    return column < num_columns() && present[column];
+}
+
+float *summary_record::column(int column) {
+    present[column] = 1;
+    return data.data() + static_cast<size_t>(column) * steps;
+}
+
+void summary_record::fwrite(buffer_type *buffer) const {
+    buffer_fwrite_int(buffer, SUMMARY_RECORD_ID);
+    buffer_fwrite_int(buffer, num_columns());
+    buffer_fwrite_int(buffer, steps);
+    buffer_fwrite(buffer, present.data(), sizeof(char), present.size());
+    buffer_fwrite(buffer, data.data(), sizeof(float), data.size());
+}
+
+void summary_record::fread(buffer_type *buffer) {
+    if (buffer_fread_int(buffer) != SUMMARY_RECORD_ID)
+        util_abort("%s: buffer does not contain a summary record\n", __func__);
+
+    int num_columns = buffer_fread_int(buffer);
+    steps = buffer_fread_int(buffer);
+    present.resize(num_columns);
+    data.resize(static_cast<size_t>(num_columns) * steps);
+    buffer_fread(buffer, present.data(), sizeof(char), present.size());
+    buffer_fread(buffer, data.data(), sizeof(float), data.size());
+}
+
+bool summary_record::fread_column(const range_reader &read_range, int column,
+                                  std::vector<float> *values) {
+    int header[3];
+    read_range(0, header, sizeof header);
+    if (header[0] != SUMMARY_RECORD_ID)
+        util_abort("%s: stored data is not a summary record\n", __func__);
+
+    const int num_columns = header[1];
+    const int num_steps = header[2];
+    if (column >= num_columns)
+        return false;
+
+    char column_present;
+    read_range(present_offset(column), &column_present, sizeof column_present);
+    if (!column_present)
+        return false;
+
+    if (values) {
+        values->resize(num_steps);
+        read_range(column_offset(num_columns, num_steps, column),
+                   values->data(), sizeof(float) * num_steps);
+    }
+    return true;
+}
+
+void summary_record_fwrite_vector(buffer_type *buffer,
+                                  const std::vector<float> &values) {
+    const float undefined = summary_undefined_value();
+    auto size = values.size();
+    while (size > 0 && values[size - 1] == undefined)
+        size--;
+
+    buffer_fwrite_time_t(buffer, time(NULL));
+    buffer_fwrite_int(buffer, SUMMARY);
+    buffer_fwrite_int(buffer, static_cast<int>(size));
+    buffer_fwrite_double(buffer, summary_undefined_value());
+    for (size_t i = 0; i < size; i++)
+        buffer_fwrite_double(buffer, values[i]);
+}
+
+} // namespace ert
@@ -16,18 +16,25 @@
    for more details.
 */
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <ctime>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
-#include <map>
+#include <iterator>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include <stdlib.h>
 
+#include <fmt/format.h>
+
+#include <ert/res_util/runpath_manifest.hpp>
 #include <ert/util/stringlist.h>
 
 #include <ert/enkf/value_export.hpp>
@@ -36,11 +43,25 @@ namespace fs = std::filesystem;
 
 #define VALUE_EXPORT_TYPE_ID 5741761
 
+struct value_export_layout {
+    /** The keys and subkeys in the order they were appended. */
+    std::vector<std::pair<std::string, std::string>> keys;
+    /** The indices of the values sorted on key and subkey; of a key and
+     * subkey which is appended more than once only the last is exported. */
+    std::vector<int> order;
+};
+
 struct value_export_struct {
     UTIL_TYPE_ID_DECLARATION;
     std::string directory;
     std::string base_name;
-    std::map<std::string, std::map<std::string, double>> values;
+    /** While the values are appended in the order of the layout, only the
+     * values are stored and keys is empty. */
+    mutable std::shared_ptr<const value_export_layout> layout;
+    mutable std::vector<std::pair<std::string, std::string>> keys;
+    std::vector<double> values;
+    /** When set, the files are written through the manifest. */
+    ert::runpath_manifest *manifest = NULL;
 };
 
 static void backup_if_existing(const char *filename) {
@@ -86,108 +107,216 @@ value_export_type *value_export_alloc(std::string directory,
 
 void value_export_free(value_export_type *value) { delete value; }
 
+void value_export_set_manifest(value_export_type *value,
+                               ert::runpath_manifest *manifest) {
+    value->manifest = manifest;
+}
+
 int value_export_size(const value_export_type *value) {
-    int size = 0;
-    for (const auto &key_map_pair : value->values) {
-        size += key_map_pair.second.size();
-    }
+    return value_export_get_layout(value)->order.size();
+}
 
-    return size;
+/** Stores the keys of the values appended so far, and stops following the
+ * layout. */
+static void value_export_detach_layout(const value_export_type *value) {
+    if (value->layout && value->keys.size() < value->values.size())
+        value->keys.assign(value->layout->keys.begin(),
+                           value->layout->keys.begin() + value->values.size());
+    value->layout.reset();
 }
 
-void value_export_txt__(const value_export_type *value, const char *filename) {
+void value_export_set_layout(
+    value_export_type *value,
+    std::shared_ptr<const value_export_layout> layout) {
+    value_export_detach_layout(value);
+    if (value->values.empty())
+        value->layout = std::move(layout);
+}
 
-    if (!value->values.empty()) {
-        FILE *stream = util_fopen(filename, "w");
-        for (const auto &key_map_pair : value->values) {
-            for (const auto &sub_key_value_pair : key_map_pair.second) {
-                fprintf(stream, "%s:%s %g\n", key_map_pair.first.c_str(),
-                        sub_key_value_pair.first.c_str(),
-                        sub_key_value_pair.second);
-            }
-        }
-        fclose(stream);
+std::shared_ptr<const value_export_layout>
+value_export_get_layout(const value_export_type *value) {
+    if (value->layout &&
+        value->layout->keys.size() == value->values.size() &&
+        value->keys.empty())
+        return value->layout;
+    value_export_detach_layout(value);
+
+    auto layout = std::make_shared<value_export_layout>();
+    layout->keys = value->keys;
+
+    std::vector<int> order(layout->keys.size());
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return layout->keys[a] < layout->keys[b];
+    });
+    for (size_t i = 0; i < order.size(); i++) {
+        if (i + 1 < order.size() &&
+            layout->keys[order[i]] == layout->keys[order[i + 1]])
+            continue;
+        layout->order.push_back(order[i]);
     }
+
+    value->layout = layout;
+    value->keys.clear();
+    return layout;
 }
 
-void value_export_txt(const value_export_type *value) {
-    std::string filename = value->directory + "/" + value->base_name + ".txt";
-    backup_if_existing(filename.c_str());
-    value_export_txt__(value, filename.c_str());
+/**
+   Formats the value as the shortest string which is read back as the same
+   double.
+*/
+static void format_value(fmt::memory_buffer &buffer, double double_value) {
+    fmt::format_to(std::back_inserter(buffer), "{}", double_value);
 }
 
-static void generate_hirarchical_keys(const value_export_type *value,
-                                      FILE *stream) {
-    for (auto iterMaps = value->values.begin(); iterMaps != value->values.end();
-         ++iterMaps) {
-        std::string key = (*iterMaps).first;
-        std::map<std::string, double> subMap = (*iterMaps).second;
-        fprintf(stream, "\"%s\" : {\n", key.c_str());
+static bool unchanged(const value_export_type *value,
+                      const fmt::memory_buffer &buffer, const char *filename) {
+    return value->manifest &&
+           value->manifest->unchanged(
+               filename, {std::string_view(buffer.data(), buffer.size())});
+}
 
-        for (auto iterValues = subMap.begin(); iterValues != subMap.end();
-             ++iterValues) {
+static void write_buffer(const value_export_type *value,
+                         const fmt::memory_buffer &buffer,
+                         const char *filename) {
+    if (value->manifest) {
+        if (!value->manifest->write_file(
+                filename, {std::string_view(buffer.data(), buffer.size())}))
+            util_abort("%s: failed to write %s\n", __func__, filename);
+        return;
+    }
 
-            std::string subkey = (*iterValues).first;
+    FILE *stream = util_fopen(filename, "w");
+    if (fwrite(buffer.data(), 1, buffer.size(), stream) != buffer.size())
+        util_abort("%s: failed to write %s\n", __func__, filename);
+    fclose(stream);
+}
 
-            double double_value = (*iterValues).second;
-            if (std::isnan(double_value))
-                fprintf(stream, "\"%s\" : NaN", subkey.c_str());
-            else
-                fprintf(stream, "\"%s\" : %g", subkey.c_str(), double_value);
+static void format_txt(const value_export_type *value,
+                       const value_export_layout &layout,
+                       fmt::memory_buffer &buffer) {
+    for (int index : layout.order) {
+        const auto &[key, subkey] = layout.keys[index];
+        fmt::format_to(std::back_inserter(buffer), "{}:{} ", key, subkey);
+        format_value(buffer, value->values[index]);
+        buffer.push_back('\n');
+    }
+}
 
-            if (std::next(iterValues) != subMap.end())
-                fprintf(stream, ",");
-            fprintf(stream, "\n");
-        }
+void value_export_txt__(const value_export_type *value, const char *filename) {
+    auto layout = value_export_get_layout(value);
+    if (layout->order.empty())
+        return;
 
-        fprintf(stream, "},\n");
-    }
+    fmt::memory_buffer buffer;
+    format_txt(value, *layout, buffer);
+    write_buffer(value, buffer, filename);
 }
 
-static void generate_comosite_keys(const value_export_type *value,
-                                   FILE *stream) {
-    for (auto iterMaps = value->values.begin(); iterMaps != value->values.end();
-         ++iterMaps) {
-        std::string key = (*iterMaps).first;
-        std::map<std::string, double> subMap = (*iterMaps).second;
+/**
+   Writes the values to <base_name>.txt, after the existing file has been
+   moved to a backup. With a manifest a file with the same content is left
+   as it is, without a backup.
+*/
+void value_export_txt(const value_export_type *value) {
+    std::string filename = value->directory + "/" + value->base_name + ".txt";
+    auto layout = value_export_get_layout(value);
+    if (layout->order.empty()) {
+        backup_if_existing(filename.c_str());
+        return;
+    }
 
-        for (auto iterValues = subMap.begin(); iterValues != subMap.end();
-             ++iterValues) {
+    fmt::memory_buffer buffer;
+    format_txt(value, *layout, buffer);
+    if (unchanged(value, buffer, filename.c_str()))
+        return;
+    backup_if_existing(filename.c_str());
+    write_buffer(value, buffer, filename.c_str());
+}
 
-            std::string subkey = (*iterValues).first;
+/**
+   Calls group(begin, end) for each key, with the range of the sorted
+   indices of its subkeys.
+*/
+template <typename F>
+static void for_each_key(const value_export_layout &layout, F group) {
+    auto begin = layout.order.begin();
+    while (begin != layout.order.end()) {
+        const std::string &key = layout.keys[*begin].first;
+        auto end = std::find_if(begin, layout.order.end(), [&](int index) {
+            return layout.keys[index].first != key;
+        });
+        group(begin, end);
+        begin = end;
+    }
+}
 
-            double double_value = (*iterValues).second;
+static void generate_hirarchical_keys(const value_export_type *value,
+                                      const value_export_layout &layout,
+                                      fmt::memory_buffer &buffer) {
+    auto out = std::back_inserter(buffer);
+    for_each_key(layout, [&](auto begin, auto end) {
+        fmt::format_to(out, "\"{}\" : {{\n", layout.keys[*begin].first);
+        for (auto iter = begin; iter != end; ++iter) {
+            double double_value = value->values[*iter];
+            fmt::format_to(out, "\"{}\" : ", layout.keys[*iter].second);
             if (std::isnan(double_value))
-                fprintf(stream, "\"%s\" : NaN", key.c_str());
+                fmt::format_to(out, "NaN");
             else
-                fprintf(stream, "\"%s:%s\" : %g", key.c_str(), subkey.c_str(),
-                        double_value);
+                format_value(buffer, double_value);
 
-            if (std::next(iterValues) != subMap.end()) {
-                fprintf(stream, ",");
-                fprintf(stream, "\n");
-            }
+            if (std::next(iter) != end)
+                buffer.push_back(',');
+            buffer.push_back('\n');
         }
+        fmt::format_to(out, "}},\n");
+    });
+}
 
-        if (std::next(iterMaps) != value->values.end())
-            fprintf(stream, ",");
+static void generate_comosite_keys(const value_export_type *value,
+                                   const value_export_layout &layout,
+                                   fmt::memory_buffer &buffer) {
+    auto out = std::back_inserter(buffer);
+    for_each_key(layout, [&](auto begin, auto end) {
+        for (auto iter = begin; iter != end; ++iter) {
+            const auto &[key, subkey] = layout.keys[*iter];
+            double double_value = value->values[*iter];
+            if (std::isnan(double_value))
+                fmt::format_to(out, "\"{}\" : NaN", key);
+            else {
+                fmt::format_to(out, "\"{}:{}\" : ", key, subkey);
+                format_value(buffer, double_value);
+            }
 
-        fprintf(stream, "\n");
-    }
+            if (std::next(iter) != end)
+                fmt::format_to(out, ",\n");
+        }
+
+        if (end != layout.order.end())
+            buffer.push_back(',');
+        buffer.push_back('\n');
+    });
 }
 
+/** As value_export_txt(), for <base_name>.json. */
 void value_export_json(const value_export_type *value) {
     std::string filename = value->directory + "/" + value->base_name + ".json";
-    backup_if_existing(filename.c_str());
-
-    if (!value->values.empty()) {
-        FILE *stream = util_fopen(filename.c_str(), "w");
-        fprintf(stream, "{\n");
-        generate_hirarchical_keys(value, stream);
-        generate_comosite_keys(value, stream);
-        fprintf(stream, "}\n");
-        fclose(stream);
+    auto layout = value_export_get_layout(value);
+    if (layout->order.empty()) {
+        backup_if_existing(filename.c_str());
+        return;
     }
+
+    fmt::memory_buffer buffer;
+    fmt::format_to(std::back_inserter(buffer), "{{\n");
+    generate_hirarchical_keys(value, *layout, buffer);
+    generate_comosite_keys(value, *layout, buffer);
+    fmt::format_to(std::back_inserter(buffer), "}}\n");
+    if (unchanged(value, buffer, filename.c_str()))
+        return;
+    backup_if_existing(filename.c_str());
+    write_buffer(value, buffer, filename.c_str());
 }
 
 void value_export(const value_export_type *value) {
@@ -195,14 +324,21 @@ void value_export(const value_export_type *value) {
     value_export_json(value);
 }
 
+/**
+   Appends the value; while the keys are appended in the same order as in
+   the layout, they are not stored.
+*/
 void value_export_append(value_export_type *value, const std::string key,
                          const std::string subkey, double double_value) {
-
-    if (value->values.find(key) == value->values.end()) {
-        value->values[key] = std::map<std::string, double>();
+    size_t index = value->values.size();
+    const auto &layout = value->layout;
+    if (!(layout && value->keys.empty() && index < layout->keys.size() &&
+          layout->keys[index].first == key &&
+          layout->keys[index].second == subkey)) {
+        value_export_detach_layout(value);
+        value->keys.emplace_back(key, subkey);
     }
-
-    value->values[key][subkey] = double_value;
+    value->values.push_back(double_value);
 }
 
 UTIL_IS_INSTANCE_FUNCTION(value_export, VALUE_EXPORT_TYPE_ID)
@@ -37,6 +37,40 @@ public:
     UpdateSnapshot update_snapshot;
 };
 
+/**
+ * Settings for the optional reduction of dense observation groups before the
+ * update. Each observation key with at least min_size active elements is
+ * replaced either by averages over blocks of block_size consecutive elements,
+ * or (block_size == 0) by the leading principal components of the error
+ * normalised ensemble responses which explain variance_fraction of the
+ * variance. The default constructed object disables the reduction.
+*/
+struct ObservationReduction {
+    int min_size = 0;
+    int block_size = 0;
+    double variance_fraction = 0.99;
+
+    bool enabled() const { return min_size > 0; }
+};
+
+/** The rows of one observation key in the stacked observations. */
+struct ObservationGroup {
+    std::string key;
+    int row_offset;
+    int size;
+};
+
+/**
+ * Observations, errors and responses for one observation group after the
+ * reduction; the errors are independent, i.e. R is diagonal also in the
+ * reduced space.
+*/
+struct ReducedObservations {
+    Eigen::MatrixXd S;
+    Eigen::VectorXd values;
+    Eigen::VectorXd errors;
+};
+
 class Parameter : public std::enable_shared_from_this<Parameter> {
 public:
     std::string name;
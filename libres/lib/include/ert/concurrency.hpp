@@ -1,30 +1,99 @@
 #ifndef ERT_CONCURRENCY_HPP
 #define ERT_CONCURRENCY_HPP
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
-// Standard support for semaphores arrived in C++20, so make our own for now
-// Idea and most of code is from
-//  https://raymii.org/s/tutorials/Cpp_std_async_with_a_concurrency_limit.html
-// and the class-name is intentionally left like the original :)
-class Semafoor {
+namespace ert {
+
+/**
+ A fixed number of worker threads executing the submitted tasks in the order
+ they are submitted. The result of a task, or the exception it throws, is
+ delivered through the future returned by submit(). The destructor waits for
+ all submitted tasks to complete.
+*/
+class worker_pool {
 public:
-    explicit Semafoor(size_t count) : count(count) {}
-    void lock() {
-        std::unique_lock<std::mutex> lock(mutex);
-        condition_variable.wait(lock, [this] { return (count != 0); });
-        --count;
+    explicit worker_pool(size_t num_threads) {
+        num_threads = std::max<size_t>(num_threads, 1);
+        for (size_t i = 0; i < num_threads; i++)
+            workers.emplace_back([this] { this->run(); });
+    }
+
+    ~worker_pool() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition_variable.notify_all();
+        for (auto &worker : workers)
+            worker.join();
     }
-    void unlock() {
-        std::unique_lock<std::mutex> lock(mutex);
-        ++count;
+
+    worker_pool(const worker_pool &) = delete;
+    worker_pool &operator=(const worker_pool &) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F &&task) {
+        using result_type = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<result_type()>>(
+            std::forward<F>(task));
+        auto future = packaged->get_future();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            tasks.emplace_back([packaged] { (*packaged)(); });
+        }
         condition_variable.notify_one();
+        return future;
+    }
+
+    /**
+     The number of threads to use for tasks which mostly wait for I/O: a few
+     threads per core, so that the cores are kept busy while some of the
+     threads are waiting, but not more than max_threads.
+    */
+    static size_t io_bound_size(size_t max_threads) {
+        const size_t threads_per_core = 4;
+        size_t cores = std::max(std::thread::hardware_concurrency(), 1u);
+        return std::clamp<size_t>(cores * threads_per_core, 1,
+                                  std::max<size_t>(max_threads, 1));
     }
 
 private:
+    void run() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition_variable.wait(
+                    lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty())
+                    return;
+
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
     std::mutex mutex;
     std::condition_variable condition_variable;
-    size_t count;
+    std::deque<std::function<void()>> tasks;
+    bool stopping = false;
+    std::vector<std::thread> workers;
 };
 
+} // namespace ert
+
 #endif
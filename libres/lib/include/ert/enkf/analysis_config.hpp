@@ -56,7 +56,9 @@ void analysis_config_init(analysis_config_type *analysis,
 extern "C" PY_USED analysis_config_type *analysis_config_alloc_full(
     double alpha, bool rerun, int rerun_start, const char *log_path,
     double std_cutoff, bool stop_long_running, bool single_node_update,
-    double global_std_scaling, int max_runtime, int min_realisations);
+    double global_std_scaling, int max_runtime, int min_realisations,
+    int obs_reduction_min_size, int obs_reduction_block_size,
+    double obs_reduction_variance);
 analysis_config_type *analysis_config_alloc_default(void);
 extern "C" analysis_config_type *
 analysis_config_alloc_load(const char *user_config_file);
@@ -80,6 +82,12 @@ extern "C" void analysis_config_set_std_cutoff(analysis_config_type *config,
                                                double std_cutoff);
 extern "C" double
 analysis_config_get_std_cutoff(const analysis_config_type *config);
+extern "C" PY_USED int analysis_config_get_obs_reduction_min_size(
+    const analysis_config_type *config);
+extern "C" PY_USED int analysis_config_get_obs_reduction_block_size(
+    const analysis_config_type *config);
+extern "C" PY_USED double analysis_config_get_obs_reduction_variance(
+    const analysis_config_type *config);
 void analysis_config_add_config_items(config_parser_type *config);
 
 extern "C" bool analysis_config_select_module(analysis_config_type *config,
@@ -21,7 +21,10 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <string>
+#include <vector>
 
+#include <ert/enkf/enkf_types.hpp>
 #include <ert/enkf/fs_types.hpp>
 
 typedef struct buffer_struct buffer_type;
@@ -52,13 +55,26 @@ public:
 
     bool has_vector(const char *node_key, int iens);
     void load_vector(const char *node_key, int iens, buffer_type *buffer);
+    void load_vector_range(const char *node_key, int iens, size_t offset,
+                           void *ptr, size_t byte_size);
     void save_vector(const char *node_key, int iens, buffer_type *buffer);
 
+    std::vector<bool> has_nodes(const char *node_key,
+                                const std::vector<node_id_type> &node_ids);
+    std::vector<bool> has_vectors(const char *node_key,
+                                  const std::vector<int> &iens_list);
+    std::vector<bool> load_nodes(const std::vector<std::string> &node_keys,
+                                 const std::vector<node_id_type> &node_ids,
+                                 const std::vector<buffer_type *> &buffers);
+
     void fsync();
 
 private:
     void mount();
     bfs_type *get_fs(int iens);
+    std::vector<bool>
+    has_files(const std::vector<int> &iens_list,
+              const std::vector<std::vector<std::string>> &fs_keys);
 };
 
 } // namespace ert
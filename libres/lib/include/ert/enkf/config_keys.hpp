@@ -78,6 +78,9 @@
 #define NUM_REALIZATIONS_KEY "NUM_REALIZATIONS"
 #define MIN_REALIZATIONS_KEY "MIN_REALIZATIONS"
 #define OBS_CONFIG_KEY "OBS_CONFIG"
+#define OBS_REDUCTION_BLOCK_SIZE_KEY "OBS_REDUCTION_BLOCK_SIZE"
+#define OBS_REDUCTION_MIN_SIZE_KEY "OBS_REDUCTION_MIN_SIZE"
+#define OBS_REDUCTION_VARIANCE_KEY "OBS_REDUCTION_VARIANCE"
 #define QUEUE_SYSTEM_KEY "QUEUE_SYSTEM"
 #define QUEUE_OPTION_KEY "QUEUE_OPTION"
 #define HOOK_WORKFLOW_KEY "HOOK_WORKFLOW"
@@ -93,6 +96,7 @@
 #define SIMULATION_JOB_KEY "SIMULATION_JOB"
 #define STD_CUTOFF_KEY "STD_CUTOFF"
 #define SUMMARY_KEY "SUMMARY"
+#define SUMMARY_TABLE_KEY "SUMMARY_TABLE"
 #define SURFACE_KEY "SURFACE"
 #define UPDATE_LOG_PATH_KEY "UPDATE_LOG_PATH"
 #define UPDATE_PATH_KEY "UPDATE_PATH"
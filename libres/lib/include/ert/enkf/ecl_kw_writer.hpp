@@ -0,0 +1,49 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'ecl_kw_writer.hpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_ECL_KW_WRITER_H
+#define ERT_ECL_KW_WRITER_H
+
+#include <stdio.h>
+
+#include <ert/ecl/ecl_type.h>
+
+namespace ert {
+
+/**
+   Writes the size elements of data as the keyword kw in the GRDECL format.
+   The output is the same as from ecl_kw_fprintf_grdecl(), but the numbers
+   are formatted without stdio, and the text is written in large chunks.
+   The data_type must be float, double or int.
+*/
+void fwrite_grdecl(FILE *stream, const char *kw, ecl_data_type data_type,
+                   int size, const void *data);
+
+/**
+   Writes the size elements of data as the keyword kw in the unformatted
+   ECLIPSE format. The output is the same as from
+   ecl_kw_fwrite_param_fortio() to an unformatted fortio with
+   ECL_ENDIAN_FLIP, but the records are assembled in memory and written
+   with one fwrite(). The data_type must be float, double or int.
+*/
+void fwrite_ecl_kw(FILE *stream, const char *kw, ecl_data_type data_type,
+                   int size, const void *data);
+
+} // namespace ert
+
+#endif
@@ -19,6 +19,8 @@
 #ifndef ERT_ENKF_CONFIG_NODE_H
 #define ERT_ENKF_CONFIG_NODE_H
 
+#include <vector>
+
 #include <ert/util/hash.h>
 #include <ert/util/stringlist.h>
 
@@ -43,6 +45,13 @@ bool enkf_config_node_has_vector(const enkf_config_node_type *node,
                                  enkf_fs_type *fs, int iens);
 bool enkf_config_node_has_node(const enkf_config_node_type *node,
                                enkf_fs_type *fs, node_id_type node_id);
+std::vector<bool>
+enkf_config_node_has_vectors(const enkf_config_node_type *node,
+                             enkf_fs_type *fs,
+                             const std::vector<int> &iens_list);
+std::vector<bool>
+enkf_config_node_has_nodes(const enkf_config_node_type *node, enkf_fs_type *fs,
+                           const std::vector<node_id_type> &node_ids);
 bool enkf_config_node_vector_storage(const enkf_config_node_type *config_node);
 
 void enkf_config_node_update_min_std(enkf_config_node_type *config_node,
@@ -148,6 +157,9 @@ void enkf_config_node_set_internalize(enkf_config_node_type *node,
                                       int report_step);
 bool enkf_config_node_internalize(const enkf_config_node_type *node,
                                   int report_step);
+std::vector<int>
+enkf_config_node_get_internalize_steps(const enkf_config_node_type *node,
+                                       int start, int stop);
 
 void enkf_config_node_fprintf_config(const enkf_config_node_type *config_node,
                                      FILE *stream);
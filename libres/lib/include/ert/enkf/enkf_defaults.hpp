@@ -83,6 +83,9 @@
 */
 #define DEFAULT_ENKF_ALPHA 3.0
 #define DEFAULT_ENKF_STD_CUTOFF 1e-6
+#define DEFAULT_OBS_REDUCTION_MIN_SIZE 0
+#define DEFAULT_OBS_REDUCTION_BLOCK_SIZE 0
+#define DEFAULT_OBS_REDUCTION_VARIANCE 0.99
 #define DEFAULT_RERUN false
 #define DEFAULT_RERUN_START 0
 #define DEFAULT_UPDATE_LOG_PATH "update_log"
@@ -105,6 +108,9 @@
 
 #define DEFAULT_WORKFLOW_VERBOSE false
 
+/* Upper limit (bytes) for the responses cached in memory per enkf_fs. */
+#define DEFAULT_MEASUREMENT_CACHE_SIZE (1024 * 1024 * 1024)
+
 /*
   Some #define symbols used when saving configuration files.
 */
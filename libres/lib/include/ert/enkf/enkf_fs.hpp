@@ -19,6 +19,8 @@
 #ifndef ERT_ENKF_FS_H
 #define ERT_ENKF_FS_H
 #include <stdbool.h>
+#include <string>
+#include <vector>
 
 #include <ert/util/buffer.h>
 #include <ert/util/stringlist.h>
@@ -29,9 +31,13 @@
 #include <ert/enkf/enkf_types.hpp>
 #include <ert/enkf/fs_driver.hpp>
 #include <ert/enkf/fs_types.hpp>
+#include <ert/enkf/load_report.hpp>
+#include <ert/enkf/load_sources.hpp>
+#include <ert/enkf/measurement_cache.hpp>
 #include <ert/enkf/misfit_ensemble_typedef.hpp>
 #include <ert/enkf/state_map.hpp>
 #include <ert/enkf/summary_key_set.hpp>
+#include <ert/enkf/summary_table.hpp>
 #include <ert/enkf/time_map.hpp>
 
 const char *enkf_fs_get_mount_point(const enkf_fs_type *fs);
@@ -64,6 +70,12 @@ void enkf_fs_fread_node(enkf_fs_type *enkf_fs, buffer_type *buffer,
                         const char *node_key, enkf_var_type var_type,
                         int report_step, int iens);
 
+std::vector<bool>
+enkf_fs_fread_nodes(enkf_fs_type *enkf_fs,
+                    const std::vector<std::string> &node_keys,
+                    enkf_var_type var_type, std::vector<node_id_type> node_ids,
+                    const std::vector<buffer_type *> &buffers);
+
 void enkf_fs_fread_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
                           const char *node_key, enkf_var_type var_type,
                           int iens);
@@ -72,6 +84,13 @@ bool enkf_fs_has_vector(enkf_fs_type *enkf_fs, const char *node_key,
                         enkf_var_type var_type, int iens);
 bool enkf_fs_has_node(enkf_fs_type *enkf_fs, const char *node_key,
                       enkf_var_type var_type, int report_step, int iens);
+std::vector<bool> enkf_fs_has_vectors(enkf_fs_type *enkf_fs,
+                                      const char *node_key,
+                                      enkf_var_type var_type,
+                                      const std::vector<int> &iens_list);
+std::vector<bool> enkf_fs_has_nodes(enkf_fs_type *enkf_fs, const char *node_key,
+                                    enkf_var_type var_type,
+                                    const std::vector<node_id_type> &node_ids);
 
 extern "C" enkf_fs_type *enkf_fs_create_fs(const char *mount_point,
                                            fs_driver_impl driver_id,
@@ -98,6 +117,22 @@ extern "C" state_map_type *enkf_fs_get_state_map(const enkf_fs_type *fs);
 extern "C" time_map_type *enkf_fs_get_time_map(const enkf_fs_type *fs);
 cases_config_type *enkf_fs_get_cases_config(const enkf_fs_type *fs);
 misfit_ensemble_type *enkf_fs_get_misfit_ensemble(const enkf_fs_type *fs);
+long enkf_fs_get_generation(const enkf_fs_type *fs);
+ert::measurement_cache &enkf_fs_get_measurement_cache(const enkf_fs_type *fs);
+bool enkf_fs_has_summary_table(const enkf_fs_type *fs);
+ert::summary_columns &enkf_fs_get_summary_columns(const enkf_fs_type *fs);
+bool enkf_fs_fread_summary_record(enkf_fs_type *fs, int iens,
+                                  ert::summary_record &record);
+void enkf_fs_fwrite_summary_record(enkf_fs_type *fs, int iens,
+                                   const ert::summary_record &record);
+bool enkf_fs_fread_load_sources(enkf_fs_type *fs, int iens,
+                                ert::load_sources &sources);
+void enkf_fs_fwrite_load_sources(enkf_fs_type *fs, int iens,
+                                 const ert::load_sources &sources);
+void enkf_fs_add_load_profile(enkf_fs_type *fs, int iens,
+                              fw_load_status status,
+                              const ert::utils::Profile &profile);
+void enkf_fs_fwrite_load_report(enkf_fs_type *fs);
 extern "C" summary_key_set_type *
 enkf_fs_get_summary_key_set(const enkf_fs_type *fs);
 
@@ -116,12 +116,13 @@ bool enkf_main_export_field_with_fs(const enkf_main_type *enkf_main,
 int enkf_main_load_from_forward_model_with_fs(enkf_main_type *enkf_main,
                                               int iter,
                                               bool_vector_type *iactive,
-                                              enkf_fs_type *fs);
+                                              enkf_fs_type *fs,
+                                              bool force_reload = false);
 
 extern "C" int
 enkf_main_load_from_run_context(enkf_main_type *enkf_main,
                                 ert_run_context_type *run_context,
-                                enkf_fs_type *fs);
+                                enkf_fs_type *fs, bool force_reload);
 
 bool enkf_main_case_is_current(const enkf_main_type *enkf_main,
                                const char *case_path);
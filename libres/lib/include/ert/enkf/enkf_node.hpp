@@ -21,6 +21,7 @@
 #include <Eigen/Dense>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <vector>
 
 #include <ert/util/buffer.h>
 #include <ert/util/hash.h>
@@ -154,7 +155,12 @@ extern "C" bool enkf_node_try_load(enkf_node_type *enkf_node, enkf_fs_type *fs,
                                    node_id_type node_id);
 bool enkf_node_try_load_vector(enkf_node_type *enkf_node, enkf_fs_type *fs,
                                int iens);
+std::vector<bool>
+enkf_node_load_nodes(const std::vector<enkf_node_type *> &nodes,
+                     enkf_fs_type *fs, node_id_type node_id);
 bool enkf_node_vector_storage(const enkf_node_type *node);
+bool enkf_node_vector_has_data(const enkf_node_type *enkf_node,
+                               int report_step);
 enkf_node_type *
 enkf_node_alloc_shared_container(const enkf_config_node_type *config,
                                  hash_type *node_hash);
@@ -54,7 +54,8 @@ void enkf_state_initialize(enkf_state_type *enkf_state, rng_type *rng,
                            init_mode_type init_mode);
 
 fw_load_status enkf_state_load_from_forward_model(enkf_state_type *enkf_state,
-                                                  run_arg_type *run_arg);
+                                                  run_arg_type *run_arg,
+                                                  bool force_reload = false);
 
 enkf_state_type *enkf_state_alloc(int, rng_type *main_rng, model_config_type *,
                                   ensemble_config_type *,
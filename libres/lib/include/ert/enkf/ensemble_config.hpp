@@ -20,6 +20,7 @@
 #define ERT_ENSEMBLE_CONFIG_H
 #include <stdbool.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,7 @@
 #include <ert/enkf/enkf_types.hpp>
 #include <ert/enkf/summary_config.hpp>
 #include <ert/enkf/summary_key_matcher.hpp>
+#include <ert/enkf/value_export.hpp>
 
 typedef struct ensemble_config_struct ensemble_config_type;
 
@@ -43,6 +45,16 @@ void ensemble_config_set_refcase(ensemble_config_type *ensemble_config,
                                  const ecl_sum_type *refcase);
 void ensemble_config_set_gen_kw_format(ensemble_config_type *ensemble_config,
                                        const char *gen_kw_format_string);
+extern "C" void
+ensemble_config_set_summary_table(ensemble_config_type *ensemble_config,
+                                  bool summary_table);
+extern "C" bool
+ensemble_config_use_summary_table(const ensemble_config_type *ensemble_config);
+std::shared_ptr<const value_export_layout>
+ensemble_config_get_export_layout(const ensemble_config_type *ensemble_config);
+void ensemble_config_set_export_layout(
+    const ensemble_config_type *ensemble_config,
+    std::shared_ptr<const value_export_layout> layout);
 enkf_config_node_type *
 ensemble_config_add_container(ensemble_config_type *ensemble_config,
                               const char *key);
@@ -97,6 +109,10 @@ extern "C" enkf_config_node_type *
 ensemble_config_get_node(const ensemble_config_type *, const char *);
 enkf_config_node_type *ensemble_config_get_or_create_summary_node(
     ensemble_config_type *ensemble_config, const char *key);
+std::vector<enkf_config_node_type *>
+ensemble_config_get_or_create_summary_nodes(
+    ensemble_config_type *ensemble_config,
+    const std::vector<std::string> &keys);
 extern "C" stringlist_type *
 ensemble_config_alloc_keylist(const ensemble_config_type *);
 std::vector<std::string>
@@ -37,7 +37,8 @@ extern "C" ert_templates_type *
 ert_templates_alloc_default(subst_list_type *parent_subst);
 extern "C" void ert_template_free(ert_template_type *ert_tamplete);
 void ert_template_instantiate(ert_template_type *ert_template, const char *path,
-                              const subst_list_type *arg_list);
+                              const subst_list_type *arg_list,
+                              ert::runpath_manifest *manifest = NULL);
 void ert_template_add_arg(ert_template_type *ert_template, const char *key,
                           const char *value);
 extern "C" subst_list_type *
@@ -57,7 +58,8 @@ ert_templates_add_template(ert_templates_type *ert_templates, const char *key,
                            const char *arg_string);
 void ert_templates_instansiate(ert_templates_type *ert_templates,
                                const char *path,
-                               const subst_list_type *arg_list);
+                               const subst_list_type *arg_list,
+                               ert::runpath_manifest *manifest = NULL);
 void ert_templates_del_template(ert_templates_type *ert_templates,
                                 const char *key);
 
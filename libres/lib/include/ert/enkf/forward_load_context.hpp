@@ -29,6 +29,7 @@
 #include <ert/enkf/enkf_fs_type.hpp>
 #include <ert/enkf/enkf_types.hpp>
 #include <ert/enkf/run_arg_type.hpp>
+#include <ert/enkf/summary_key_matcher.hpp>
 
 typedef struct forward_load_context_struct forward_load_context_type;
 
@@ -39,6 +40,10 @@ forward_load_context_get_result(const forward_load_context_type *load_context);
 extern "C" forward_load_context_type *
 forward_load_context_alloc(const run_arg_type *run_arg, bool load_summary,
                            const ecl_config_type *ecl_config);
+forward_load_context_type *forward_load_context_alloc_matching(
+    const run_arg_type *run_arg, bool load_summary,
+    const ecl_config_type *ecl_config,
+    const summary_key_matcher_type *matcher);
 extern "C" void
 forward_load_context_free(forward_load_context_type *load_context);
 const ecl_sum_type *
@@ -51,6 +56,8 @@ extern "C" int forward_load_context_get_load_step(
     const forward_load_context_type *load_context);
 enkf_fs_type *
 forward_load_context_get_sim_fs(const forward_load_context_type *load_context);
+bool forward_load_context_file_exists(
+    const forward_load_context_type *load_context, const char *filename);
 bool forward_load_context_load_restart_file(
     forward_load_context_type *load_context, int report_step);
 extern "C" void
@@ -44,6 +44,7 @@ extern "C" void gen_data_export(const gen_data_type *gen_data,
 extern "C" void gen_data_export_data(const gen_data_type *gen_data,
                                      double_vector_type *export_data);
 const char *gen_data_get_key(const gen_data_type *gen_data);
+const void *gen_data_get_ptr(const gen_data_type *gen_data);
 int gen_data_get_size(const gen_data_type *gen_data);
 void gen_data_copy_to_double_vector(const gen_data_type *gen_data,
                                     double_vector_type *vector);
@@ -81,6 +81,8 @@ gen_data_config_get_initial_size(const gen_data_config_type *config);
 void gen_data_config_assert_size(gen_data_config_type *, int, int);
 extern "C" const bool_vector_type *
 gen_data_config_get_active_mask(const gen_data_config_type *config);
+int gen_data_config_get_active_mask_version(
+    const gen_data_config_type *config);
 extern "C" void
 gen_data_config_update_active(gen_data_config_type *config,
                               const forward_load_context_type *load_context,
@@ -0,0 +1,73 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'load_report.hpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_LOAD_REPORT_H
+#define ERT_LOAD_REPORT_H
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <ert/res_util/metric.hpp>
+
+#include <ert/enkf/enkf_types.hpp>
+
+namespace ert {
+
+/**
+ The profiles of the latest loading of the results of each realization of a
+ case, i.e. the time, calls and bytes of each phase of the loading, which is
+ written as JSON. The realizations are added from the loader threads.
+*/
+class load_report {
+public:
+    /** Records the profile of realization iens, replacing an earlier one. */
+    void add(int iens, fw_load_status status, const utils::Profile &profile);
+    /** The number of realizations in the report. */
+    size_t size() const;
+
+    /**
+     The report, with the phases of each realization and their sum over the
+     realizations:
+
+       {"realizations": {"0": {"status": "LOAD_SUCCESSFUL",
+                               "phases": {"<phase>": {"seconds": 1.5,
+                                                      "calls": 2,
+                                                      "bytes": 1024}}}},
+        "total": {"<phase>": {...}}}
+    */
+    std::string to_json() const;
+
+    /** Writes the report to filename, replacing the file atomically. */
+    void fwrite(const std::string &filename) const;
+
+private:
+    struct realization {
+        fw_load_status status;
+        utils::Profile profile;
+    };
+
+    mutable std::mutex mutex;
+    /** Serializes the writers, which share the temporary file. */
+    mutable std::mutex write_mutex;
+    std::map<int, realization> realizations;
+};
+
+} // namespace ert
+
+#endif
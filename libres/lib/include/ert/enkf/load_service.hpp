@@ -0,0 +1,82 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'load_service.hpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_LOAD_SERVICE_H
+#define ERT_LOAD_SERVICE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+
+#include <ert/concurrency.hpp>
+#include <ert/enkf/res_config.hpp>
+#include <ert/enkf/run_arg.hpp>
+
+namespace ert {
+
+/**
+ Loads the results of realizations as their forward model completes. The
+ job queue callbacks submit each realization when it reaches success, and
+ the results are loaded on a bounded number of background threads, so that
+ the loading overlaps with the realizations which are still running.
+*/
+class load_service {
+public:
+    using load_function =
+        std::function<bool(const res_config_type *, run_arg_type *)>;
+
+    explicit load_service(size_t num_threads);
+    /** A service using load on its threads; for testing. */
+    load_service(size_t num_threads, load_function load);
+
+    /**
+     Starts loading the results of run_arg. The future holds the result of
+     enkf_state_complete_forward_modelOK(), or the exception it threw.
+    */
+    std::future<bool> submit(const res_config_type *res_config,
+                             run_arg_type *run_arg);
+    /** Blocks until all the submitted realizations have been loaded. */
+    void wait() const;
+
+    size_t submitted() const;
+    size_t loaded() const;
+    size_t failed() const;
+    size_t pending() const;
+
+    /** The service used by the forward model callbacks. */
+    static load_service &instance();
+
+private:
+    void complete(bool ok);
+
+    load_function load;
+    mutable std::mutex mutex;
+    mutable std::condition_variable all_complete;
+    size_t num_submitted = 0;
+    size_t num_loaded = 0;
+    size_t num_failed = 0;
+    /* Declared last, so that the threads are joined before the rest of the
+       service is destroyed. */
+    worker_pool pool;
+};
+
+} // namespace ert
+
+#endif
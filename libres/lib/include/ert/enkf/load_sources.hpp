@@ -0,0 +1,106 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'load_sources.hpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_LOAD_SOURCES_H
+#define ERT_LOAD_SOURCES_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ert/util/buffer.h>
+
+namespace ert {
+
+/**
+ The total size, the latest modification time and a hash of the files a
+ result is loaded from. The hash covers a context string, which should hold
+ the configuration the result is loaded with, so that the fingerprint changes
+ when the configuration does, and a sample of the content of the files: their
+ first and last sample_size bytes. Files which do not exist are included as
+ missing.
+*/
+struct source_fingerprint {
+    static constexpr size_t sample_size = 64 * 1024;
+
+    int64_t size = 0;
+    int64_t mtime = 0;
+    uint64_t hash = 0;
+
+    bool operator==(const source_fingerprint &other) const {
+        return size == other.size && mtime == other.mtime &&
+               hash == other.hash;
+    }
+    bool operator!=(const source_fingerprint &other) const {
+        return !(*this == other);
+    }
+
+    /** The fingerprint without the content, which does not read the files. */
+    static source_fingerprint stat_files(const std::vector<std::string> &files,
+                                         const std::string &context);
+    /** Adds the content samples of files, as given to stat_files(). */
+    void hash_samples(const std::vector<std::string> &files);
+
+    static source_fingerprint of_files(const std::vector<std::string> &files,
+                                       const std::string &context);
+};
+
+/**
+ The files a result is loaded from, with their size and modification time
+ from before the result is loaded. The content samples are only read when
+ they are needed, so that the files of a result which is loaded anyway are
+ not read an extra time before they are loaded.
+*/
+struct result_files {
+    std::vector<std::string> files;
+    source_fingerprint stat;
+
+    result_files(std::vector<std::string> files, const std::string &context);
+    /** The full fingerprint; reads the content samples. */
+    source_fingerprint fingerprint() const;
+};
+
+/**
+ The fingerprints of the files the results of one realization were loaded
+ from, by result key; a result whose files have the same fingerprint again
+ does not need to be loaded again.
+*/
+class load_sources {
+public:
+    bool unchanged(const std::string &key,
+                   const source_fingerprint &fingerprint) const;
+    /**
+     Whether the files of key have the recorded fingerprint. The content
+     samples are only read when the size and modification time match.
+    */
+    bool unchanged(const std::string &key, const result_files &files) const;
+    void set(const std::string &key, const source_fingerprint &fingerprint);
+    void set(const std::string &key, const result_files &files);
+    void erase(const std::string &key);
+
+    void fwrite(buffer_type *buffer) const;
+    void fread(buffer_type *buffer);
+
+private:
+    std::unordered_map<std::string, source_fingerprint> sources;
+};
+
+} // namespace ert
+
+#endif
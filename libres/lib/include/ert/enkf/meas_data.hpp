@@ -44,6 +44,10 @@ extern "C" bool meas_block_iens_active(const meas_block_type *meas_block,
                                        int iens);
 extern "C" void meas_block_iset(meas_block_type *meas_block, int iens, int iobs,
                                 double value);
+template <typename T>
+void meas_block_iset_gather(meas_block_type *meas_block, int iens,
+                            const std::vector<int> &obs_index,
+                            const std::vector<int> &data_index, const T *data);
 extern "C" double meas_block_iget(const meas_block_type *meas_block, int iens,
                                   int iobs);
 extern "C" double meas_block_iget_ens_mean(meas_block_type *meas_block,
@@ -52,6 +56,7 @@ extern "C" double meas_block_iget_ens_std(meas_block_type *meas_block,
                                           int iobs);
 void meas_block_deactivate(meas_block_type *meas_block, int iobs);
 bool meas_block_iget_active(const meas_block_type *meas_block, int iobs);
+meas_block_type *meas_block_alloc_copy(const meas_block_type *src);
 extern "C" void meas_block_free(meas_block_type *meas_block);
 
 extern "C" bool meas_data_has_block(const meas_data_type *matrix,
@@ -69,6 +74,8 @@ extern "C" int meas_data_get_active_ens_size(const meas_data_type *meas_data);
 extern "C" meas_block_type *meas_data_add_block(meas_data_type *matrix,
                                                 const char *obs_key,
                                                 int report_step, int obs_size);
+void meas_data_add_block_copy(meas_data_type *matrix, int report_step,
+                              const meas_block_type *src);
 extern "C" int meas_data_get_num_blocks(const meas_data_type *meas_block);
 extern "C" meas_block_type *meas_data_iget_block(const meas_data_type *matrix,
                                                  int block_mnr);
@@ -0,0 +1,82 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'measurement_cache.hpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_MEASUREMENT_CACHE_H
+#define ERT_MEASUREMENT_CACHE_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ert/enkf/meas_data.hpp>
+
+namespace ert {
+
+/**
+ The responses measured for one observation vector, i.e. the blocks
+ enkf_obs_get_obs_and_measure_data() appends to meas_data for it (with their
+ report step), and the observation rows which were deactivated while
+ measuring.
+*/
+struct measurement {
+    std::vector<std::pair<int, std::shared_ptr<const meas_block_type>>> blocks;
+    std::vector<std::pair<int, std::string>> deactivated;
+
+    size_t byte_size() const;
+};
+
+/**
+ In-memory cache of measured responses, owned by an enkf_fs instance. An entry
+ is only returned for the same observation vector version, storage generation
+ and list of active realizations it was measured with. Storing an entry for a
+ new storage generation drops all entries from older generations. Entries are
+ not stored when they would make the cache exceed max_bytes.
+*/
+class measurement_cache {
+public:
+    explicit measurement_cache(size_t max_bytes) : max_bytes(max_bytes) {}
+
+    std::shared_ptr<const measurement>
+    get(const std::string &obs_key, long obs_version, long generation,
+        const std::vector<int> &ens_active_list) const;
+    void put(const std::string &obs_key, long obs_version, long generation,
+             const std::vector<int> &ens_active_list,
+             std::shared_ptr<const measurement> value);
+    void clear();
+
+private:
+    struct entry {
+        long obs_version;
+        long generation;
+        std::vector<int> ens_active_list;
+        std::shared_ptr<const measurement> value;
+    };
+
+    size_t max_bytes;
+    size_t total_bytes = 0;
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, entry> entries;
+};
+
+} // namespace ert
+
+#endif
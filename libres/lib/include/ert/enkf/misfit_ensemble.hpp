@@ -35,6 +35,8 @@ void misfit_ensemble_free(misfit_ensemble_type *table);
 void misfit_ensemble_fwrite(const misfit_ensemble_type *misfit_ensemble,
                             FILE *stream);
 bool misfit_ensemble_initialized(const misfit_ensemble_type *misfit_ensemble);
+bool misfit_ensemble_modified(const misfit_ensemble_type *misfit_ensemble);
+void misfit_ensemble_set_saved(misfit_ensemble_type *misfit_ensemble);
 
 void misfit_ensemble_initialize(misfit_ensemble_type *misfit_ensemble,
                                 const ensemble_config_type *ensemble_config,
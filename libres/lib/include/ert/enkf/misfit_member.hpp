@@ -21,6 +21,8 @@
 
 #include <stdio.h>
 
+#include <Eigen/Dense>
+
 #include <ert/enkf/misfit_ts.hpp>
 
 typedef struct misfit_member_struct misfit_member_type;
@@ -32,7 +34,9 @@ misfit_member_type *misfit_member_fread_alloc(FILE *stream);
 void misfit_member_fwrite(const misfit_member_type *node, FILE *stream);
 void misfit_member_update(misfit_member_type *node, const char *obs_key,
                           int history_length, int iens,
-                          const double **work_chi2);
+                          const Eigen::MatrixXd &work_chi2);
+bool misfit_member_equal(const misfit_member_type *node1,
+                         const misfit_member_type *node2);
 void misfit_member_free__(void *node);
 misfit_member_type *misfit_member_alloc(int iens);
 
@@ -29,5 +29,6 @@ misfit_ts_type *misfit_ts_alloc(int history_length);
 misfit_ts_type *misfit_ts_fread_alloc(FILE *stream);
 void misfit_ts_free__(void *vector);
 void misfit_ts_iset(misfit_ts_type *vector, int time_index, double value);
+bool misfit_ts_equal(const misfit_ts_type *ts1, const misfit_ts_type *ts2);
 
 #endif
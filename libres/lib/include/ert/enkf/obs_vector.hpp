@@ -22,6 +22,8 @@
 #include <time.h>
 #include <vector>
 
+#include <Eigen/Dense>
+
 #include <ert/util/bool_vector.h>
 #include <ert/util/int_vector.h>
 
@@ -60,6 +62,7 @@ typedef double(obs_chi2_ftype)(const void *, const void *, node_id_type);
 
 extern "C" void obs_vector_free(obs_vector_type *);
 extern "C" int obs_vector_get_num_active(const obs_vector_type *);
+long obs_vector_get_version(const obs_vector_type *vector);
 extern "C" bool obs_vector_iget_active(const obs_vector_type *, int);
 void obs_vector_iget_observations(const obs_vector_type *, int, obs_data_type *,
                                   enkf_fs_type *fs);
@@ -107,7 +110,7 @@ extern "C" void obs_vector_install_node(obs_vector_type *obs_vector,
 void obs_vector_ensemble_chi2(const obs_vector_type *obs_vector,
                               enkf_fs_type *fs, bool_vector_type *valid,
                               int step1, int step2, int iens1, int iens2,
-                              double **chi2);
+                              Eigen::MatrixXd &chi2);
 
 extern "C" double obs_vector_total_chi2(const obs_vector_type *, enkf_fs_type *,
                                         int);
@@ -1,6 +1,10 @@
 #ifndef ERT_SUMMARY_KEY_MATCHER_H
 #define ERT_SUMMARY_KEY_MATCHER_H
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <ert/util/stringlist.h>
 #include <ert/util/type_macros.h>
 
@@ -18,6 +22,10 @@ summary_key_matcher_add_summary_key(summary_key_matcher_type *matcher,
 extern "C" bool
 summary_key_matcher_match_summary_key(const summary_key_matcher_type *matcher,
                                       const char *summary_key);
+std::shared_ptr<const std::vector<bool>>
+summary_key_matcher_match_summary_keys(
+    const summary_key_matcher_type *matcher,
+    const std::vector<std::string> &summary_keys);
 extern "C" bool summary_key_matcher_summary_key_is_required(
     const summary_key_matcher_type *matcher, const char *summary_key);
 extern "C" stringlist_type *
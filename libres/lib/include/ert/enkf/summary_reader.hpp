@@ -0,0 +1,64 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'summary_reader.hpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_SUMMARY_READER_H
+#define ERT_SUMMARY_READER_H
+
+#include <vector>
+
+#include <ert/ecl/ecl_sum.hpp>
+
+#include <ert/enkf/summary_key_matcher.hpp>
+
+namespace ert {
+
+/**
+ The values of some of the columns of the PARAMS records of a unified summary
+ file: values[i][m] is the value of column params_index[i] at ministep m,
+ which belongs to report_steps[m].
+*/
+struct summary_columns_data {
+    std::vector<int> report_steps;
+    std::vector<std::vector<float>> values;
+};
+
+/**
+ Reads the columns params_index of the unformatted unified summary file
+ filename, whose PARAMS records have params_size values. The file is read
+ once, and only the selected values are decoded. Returns false if the file
+ can not be read, or does not have the expected layout.
+*/
+bool fread_summary_columns(const char *filename, int params_size,
+                           const std::vector<int> &params_index,
+                           summary_columns_data &data);
+
+} // namespace ert
+
+/**
+ Loads an ecl_sum instance with only the TIME vector and the vectors of
+ header_file which are matched by matcher, read from the unformatted unified
+ summary file unified_file. Returns NULL if that is not possible, e.g. for
+ local grid vectors, in which case the files must be loaded in full with
+ ecl_sum_fread_alloc().
+*/
+ecl_sum_type *
+summary_reader_fread_alloc(const char *header_file, const char *unified_file,
+                           const char *key_join_string,
+                           const summary_key_matcher_type *matcher);
+
+#endif
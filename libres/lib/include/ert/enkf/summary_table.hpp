@@ -0,0 +1,102 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'summary_table.hpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_SUMMARY_TABLE_H
+#define ERT_SUMMARY_TABLE_H
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ert/util/buffer.h>
+
+namespace ert {
+
+/**
+ The key dictionary of the summary table of a case: every summary key stored
+ in the table is assigned a column number, which is the same for all the
+ realizations of the case. Keys are only ever added.
+*/
+class summary_columns {
+public:
+    int size() const;
+    /** The column of key, or -1 if key is not in the table. */
+    int get(const std::string &key) const;
+    /** The column of key, which is added to the table if it is not there. */
+    int add(const std::string &key);
+
+    void fwrite(const char *filename) const;
+    bool fread(const char *filename);
+
+private:
+    mutable std::mutex mutex;
+    std::vector<std::string> keys;
+    std::unordered_map<std::string, int> columns;
+};
+
+/**
+ The summary results of one realization as one block of (columns x steps)
+ single precision values, stored column by column. A column which has not
+ been loaded for the realization is marked as not present, and the steps
+ which have not been loaded have the value summary_undefined_value().
+*/
+class summary_record {
+public:
+    /** Reads byte_size bytes at offset of a stored record into ptr. */
+    using range_reader =
+        std::function<void(size_t offset, void *ptr, size_t byte_size)>;
+
+    int num_columns() const { return static_cast<int>(present.size()); }
+    int num_steps() const { return steps; }
+
+    /** Grows the record; the existing values are kept. */
+    void resize(int num_columns, int num_steps);
+    bool has_column(int column) const;
+    /** The values of column, which is marked as present. */
+    float *column(int column);
+
+    void fwrite(buffer_type *buffer) const;
+    void fread(buffer_type *buffer);
+
+    /**
+     Reads only the values of one column from a stored record. Returns false
+     if the column is not present in the record; values can be nullptr to
+     only check that.
+    */
+    static bool fread_column(const range_reader &read_range, int column,
+                             std::vector<float> *values);
+
+private:
+    int steps = 0;
+    std::vector<char> present;
+    std::vector<float> data;
+};
+
+/**
+ Writes values to buffer in the layout of a stored SUMMARY vector, see
+ summary_write_to_buffer(); trailing undefined values are not written.
+*/
+void summary_record_fwrite_vector(buffer_type *buffer,
+                                  const std::vector<float> &values);
+
+} // namespace ert
+
+#endif
@@ -19,15 +19,30 @@
 #ifndef VALUE_EXPORT_H
 #define VALUE_EXPORT_H
 
+#include <memory>
 #include <string>
 
 #include <ert/util/type_macros.h>
 
+namespace ert {
+class runpath_manifest;
+}
+
 typedef struct value_export_struct value_export_type;
 
+/**
+   The order of the values of a value_export in the exported files, which
+   are sorted on key and subkey. The realizations append the same keys in
+   the same order, so a layout is computed once and reused by the following
+   value_export instances; see value_export_set_layout().
+*/
+struct value_export_layout;
+
 void value_export_free(value_export_type *value);
 value_export_type *value_export_alloc(std::string directory,
                                       std::string base_name);
+void value_export_set_manifest(value_export_type *value,
+                               ert::runpath_manifest *manifest);
 int value_export_size(const value_export_type *value);
 void value_export_json(const value_export_type *value);
 void value_export_txt(const value_export_type *value);
@@ -35,6 +50,10 @@ void value_export_txt__(const value_export_type *value, const char *filename);
 void value_export(const value_export_type *value);
 void value_export_append(value_export_type *value, const std::string key,
                          const std::string subkey, double double_value);
+void value_export_set_layout(value_export_type *value,
+                             std::shared_ptr<const value_export_layout> layout);
+std::shared_ptr<const value_export_layout>
+value_export_get_layout(const value_export_type *value);
 
 UTIL_IS_INSTANCE_HEADER(value_export);
 
@@ -21,6 +21,8 @@
 
 #include <stdio.h>
 
+#include <string>
+
 typedef struct env_varlist_struct env_varlist_type;
 
 extern "C" env_varlist_type *env_varlist_alloc();
@@ -30,6 +32,7 @@ void env_varlist_update_path(env_varlist_type *list, const char *path_var,
 extern "C" void env_varlist_setenv(env_varlist_type *list, const char *var,
                                    const char *value);
 void env_varlist_json_fprintf(const env_varlist_type *list, FILE *stream);
+std::string env_varlist_json(const env_varlist_type *list);
 extern "C" int env_varlist_get_size(env_varlist_type *list);
 
 extern "C" void env_varlist_free(env_varlist_type *list);
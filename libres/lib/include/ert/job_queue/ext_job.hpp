@@ -21,6 +21,7 @@
 #include <stdio.h>
 
 #include <ert/config/config_content.hpp>
+#include <ert/job_queue/jobs_json.hpp>
 #include <ert/res_util/subst_list.hpp>
 #include <ert/tooling.hpp>
 #include <ert/util/hash.hpp>
@@ -46,6 +47,8 @@ void ext_job_set_define_args(ext_job_type *ext_job,
 
 void ext_job_json_fprintf(const ext_job_type *, int job_index, FILE *,
                           const subst_list_type *);
+void ext_job_json_append(const ext_job_type *ext_job, int job_index,
+                         ert::jobs_json &json);
 extern "C" ext_job_type *ext_job_fscanf_alloc(const char *, const char *,
                                               bool private_job, const char *,
                                               bool search_path);
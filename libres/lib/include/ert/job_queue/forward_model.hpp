@@ -26,6 +26,7 @@
 
 #include <ert/job_queue/environment_varlist.hpp>
 #include <ert/job_queue/ext_joblist.hpp>
+#include <ert/job_queue/jobs_json.hpp>
 
 typedef struct forward_model_struct forward_model_type;
 
@@ -43,6 +44,13 @@ void forward_model_parse_job_deprecated_args(
 extern "C" void forward_model_formatted_fprintf(
     const forward_model_type *, const char *run_id, const char *, const char *,
     const subst_list_type *, mode_t umask, const env_varlist_type *list);
+ert::jobs_json
+forward_model_compile_json(const forward_model_type *forward_model,
+                           const char *run_id, const char *data_root,
+                           mode_t umask, const env_varlist_type *varlist);
+void forward_model_json_fwrite(const ert::jobs_json &json, const char *path,
+                               const subst_list_type *global_args,
+                               ert::runpath_manifest *manifest = NULL);
 extern "C" void forward_model_free(forward_model_type *);
 extern "C" ext_job_type *
 forward_model_iget_job(forward_model_type *forward_model, int index);
@@ -0,0 +1,80 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'jobs_json.hpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_JOBS_JSON_H
+#define ERT_JOBS_JSON_H
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <ert/res_util/subst_list.hpp>
+
+namespace ert {
+
+/**
+ The content of a jobs.json file, compiled once for all the realizations of
+ a run. The text which is the same for all the realizations is kept as it
+ is, and the strings which are filtered with the run arguments of a
+ realization are kept as slots, which are filled by render().
+*/
+class jobs_json {
+public:
+    /** The values of a hash slot, in the iteration order of the hash; a
+     * missing value is printed as null. */
+    using hash_entries =
+        std::vector<std::pair<std::string, std::optional<std::string>>>;
+    using default_mapping = std::map<std::string, std::string>;
+
+    /** Appends text which does not depend on the realization. */
+    void append(std::string_view text);
+    /** Appends the value filtered with the run arguments, in quotes. */
+    void append_string(const char *value);
+    /** As append_string(), but a filtered value which is a key of mapping
+     * is replaced with the mapped value. */
+    void append_argument(const char *value,
+                         std::shared_ptr<const default_mapping> mapping);
+    /**
+     Appends the hash of the filtered values as a JSON object; the values
+     which are filtered to a "<...>" string are left out, and an empty
+     object is printed as null_value.
+    */
+    void append_hash(hash_entries entries, const char *null_value);
+
+    /** The text with the slots filled from global_args, which can be NULL. */
+    std::string render(const subst_list_type *global_args) const;
+
+private:
+    enum class slot_type { text, string, argument, hash };
+    struct segment {
+        slot_type type;
+        std::string text;
+        std::shared_ptr<const default_mapping> mapping;
+        hash_entries entries;
+    };
+
+    std::vector<segment> segments;
+};
+
+} // namespace ert
+
+#endif
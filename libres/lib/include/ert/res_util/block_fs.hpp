@@ -19,6 +19,8 @@
 #ifndef ERT_BLOCK_FS
 #define ERT_BLOCK_FS
 #include <filesystem>
+#include <string>
+#include <vector>
 
 #include <ert/util/buffer.hpp>
 #include <ert/util/type_macros.hpp>
@@ -39,7 +41,15 @@ void block_fs_fwrite_buffer(block_fs_type *block_fs, const char *filename,
                             const buffer_type *buffer);
 void block_fs_fread_realloc_buffer(block_fs_type *block_fs,
                                    const char *filename, buffer_type *buffer);
+std::vector<bool>
+block_fs_fread_files(block_fs_type *block_fs,
+                     const std::vector<std::string> &filenames,
+                     const std::vector<buffer_type *> &buffers);
+void block_fs_fread_range(block_fs_type *block_fs, const char *filename,
+                          size_t offset, void *ptr, size_t byte_size);
 bool block_fs_has_file(block_fs_type *block_fs, const char *filename);
+std::vector<bool> block_fs_has_files(block_fs_type *block_fs,
+                                     const std::vector<std::string> &filenames);
 
 UTIL_IS_INSTANCE_HEADER(block_fs);
 UTIL_SAFE_CAST_HEADER(block_fs);
@@ -1,7 +1,10 @@
 #ifndef ERT_FILE_UTILS_H
 #define ERT_FILE_UTILS_H
 
+#include <cstdint>
 #include <filesystem>
+#include <string_view>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -11,4 +14,31 @@ namespace fs = std::filesystem;
 */
 FILE *mkdir_fopen(fs::path, const char *);
 
+/**
+   Makes target_file a reflink of source_file, which shares the data of
+   source_file until one of them is written to, creating the directory of
+   target_file if it does not exist. Returns false if the file system does
+   not support reflinks; the data is then not copied, since that would read
+   it back from source_file.
+*/
+bool clone_file(const fs::path &source_file, const fs::path &target_file);
+
+/**
+   Writes the concatenation of spans to target_file with writev(), without
+   copying them into one buffer, creating the directory of target_file if
+   it does not exist. Returns false if the write fails.
+*/
+bool write_file_spans(const fs::path &target_file,
+                      const std::vector<std::string_view> &spans);
+
+/** The initial value of hash_bytes(). */
+const uint64_t hash_bytes_seed = 0xcbf29ce484222325;
+
+/**
+   A FNV-1a style hash of size bytes at data, continued from hash, taking
+   eight bytes at a time; it only has to tell a changed file content from
+   the previous one.
+*/
+uint64_t hash_bytes(uint64_t hash, const char *data, size_t size);
+
 #endif
@@ -1,5 +1,11 @@
+#ifndef ERT_METRIC_H
+#define ERT_METRIC_H
+
 #include <chrono>
+#include <cstddef>
+#include <map>
 #include <memory>
+#include <string>
 
 #include <ert/logging.hpp>
 
@@ -23,5 +29,91 @@ private:
     std::shared_ptr<ILogger> m_logger;
 };
 
+/**
+ The time, number of calls and bytes spent in each phase of a piece of
+ work, e.g. the loading of the results of one realization. The phases are
+ recorded by ScopedTimer, into the profile which is current on the thread.
+*/
+class Profile {
+public:
+    struct Phase {
+        double seconds = 0;
+        std::size_t calls = 0;
+        std::size_t bytes = 0;
+    };
+
+    void add_time(const std::string &phase, double seconds) {
+        auto &entry = m_phases[phase];
+        entry.seconds += seconds;
+        entry.calls++;
+    }
+    void add_bytes(const std::string &phase, std::size_t bytes) {
+        m_phases[phase].bytes += bytes;
+    }
+    const std::map<std::string, Phase> &phases() const { return m_phases; }
+
+    /** The profile the phases on this thread are recorded into; NULL when
+     * nothing is profiled. */
+    static Profile *&current() {
+        thread_local Profile *profile = nullptr;
+        return profile;
+    }
+
+    /** Adds bytes to phase of the current profile, if any. */
+    static void count_bytes(const std::string &phase, std::size_t bytes) {
+        if (current())
+            current()->add_bytes(phase, bytes);
+    }
+
+private:
+    std::map<std::string, Phase> m_phases;
+};
+
+/** Makes profile the current profile of the thread in its scope. */
+class ProfileScope {
+public:
+    explicit ProfileScope(Profile &profile) : m_previous(Profile::current()) {
+        Profile::current() = &profile;
+    }
+    ~ProfileScope() { Profile::current() = m_previous; }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    Profile *m_previous;
+};
+
+/**
+ Records the time of its scope as a call of phase in the current profile of
+ the thread; does nothing when there is no current profile.
+*/
+class ScopedTimer {
+public:
+    explicit ScopedTimer(const char *phase)
+        : m_profile(Profile::current()), m_phase(phase) {
+        if (m_profile)
+            m_start = clock::now();
+    }
+
+    ~ScopedTimer() {
+        if (m_profile)
+            m_profile->add_time(
+                m_phase,
+                std::chrono::duration<double>(clock::now() - m_start).count());
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+    using clock = std::chrono::steady_clock;
+    Profile *m_profile;
+    const char *m_phase;
+    clock::time_point m_start;
+};
+
 } // namespace utils
 } // namespace ert
+
+#endif
@@ -0,0 +1,93 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'runpath_manifest.hpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_RUNPATH_MANIFEST_H
+#define ERT_RUNPATH_MANIFEST_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ert {
+
+/**
+ The content hashes of the files which are generated in a runpath, kept in
+ the file .ert_runpath_manifest of the runpath. When the runpath is created
+ again, a file is only written if its content changes; an unchanged file
+ is left as it is, with its modification time.
+
+ The size and modification time of each file are recorded along with the
+ hash, so a file which is changed or removed after it was written is
+ written again. An instance is used for one runpath at a time.
+*/
+class runpath_manifest {
+public:
+    static constexpr const char *filename = ".ert_runpath_manifest";
+
+    /** Loads the manifest of runpath; it is empty if there is none. */
+    explicit runpath_manifest(const std::filesystem::path &runpath);
+
+    /**
+     Returns true if file has the concatenation of spans as content, as
+     it was written through the manifest.
+    */
+    bool unchanged(const std::filesystem::path &file,
+                   const std::vector<std::string_view> &spans) const;
+
+    /**
+     Writes the concatenation of spans to file with write_file_spans(),
+     unless it is unchanged. Returns false if the write fails.
+    */
+    bool write_file(const std::filesystem::path &file,
+                    const std::vector<std::string_view> &spans);
+
+    /**
+     Records that file, which is written by other means, has the
+     concatenation of spans as content.
+    */
+    void add_file(const std::filesystem::path &file,
+                  const std::vector<std::string_view> &spans);
+
+    /** Forgets file, which is written by other means. */
+    void erase(const std::filesystem::path &file);
+
+    /** Writes the manifest file, if the manifest has changed. */
+    void save();
+
+private:
+    struct entry {
+        uint64_t hash;
+        int64_t size;
+        int64_t mtime;
+    };
+
+    std::string key(const std::filesystem::path &file) const;
+    bool has_content(const std::filesystem::path &file, uint64_t hash) const;
+    void set_entry(const std::filesystem::path &file, uint64_t hash);
+
+    std::filesystem::path runpath;
+    std::unordered_map<std::string, entry> entries;
+    bool modified = false;
+};
+
+} // namespace ert
+
+#endif
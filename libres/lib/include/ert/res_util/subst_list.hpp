@@ -19,6 +19,12 @@
 #ifndef ERT_SUBST_H
 #define ERT_SUBST_H
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <stdbool.h>
 #include <stdio.h>
 
@@ -35,6 +41,7 @@ void subst_list_insert_func(subst_list_type *subst_list, const char *func_name,
 void subst_list_fprintf(const subst_list_type *, FILE *stream);
 void subst_list_set_parent(subst_list_type *subst_list,
                            const subst_list_type *parent);
+long subst_list_get_version(const subst_list_type *subst_list);
 extern "C" subst_list_type *subst_list_alloc(const void *input_arg);
 subst_list_type *subst_list_alloc_deep_copy(const subst_list_type *);
 extern "C" void subst_list_free(subst_list_type *);
@@ -68,4 +75,49 @@ void subst_list_add_from_string(subst_list_type *subst_list,
                                 const char *arg_string, bool append);
 
 UTIL_IS_INSTANCE_HEADER(subst_list);
+
+namespace ert {
+
+class runpath_manifest;
+
+/**
+   A source file which is filtered with many subst_list instances, as with
+   subst_list_filter_file(); e.g. the DATA file which is written with the
+   run arguments of each realization.
+
+   The source file is read into memory once, and the places where a key
+   can be substituted are found once. Each filtered file is then written
+   with writev() from the unchanged spans of the source and the substituted
+   values, without copying the content. When the result could differ from
+   subst_list_filter_file(), e.g. when a function of the subst_list is
+   used, that is called instead.
+*/
+class subst_file_filter {
+public:
+    explicit subst_file_filter(const char *src_file);
+    subst_file_filter(const subst_file_filter &) = delete;
+    subst_file_filter &operator=(const subst_file_filter &) = delete;
+
+    /**
+       Writes the source file filtered with subst_list to target_file, and
+       returns true if something was substituted. With a manifest the file
+       is only written if it changes, see runpath_manifest.
+    */
+    bool filter(const subst_list_type *subst_list, const char *target_file,
+                runpath_manifest *manifest = NULL) const;
+
+private:
+    bool contains(const std::string &text) const;
+
+    std::string src_file;
+    std::string content;
+    /** The source has no \0, and is filtered from content. */
+    bool loaded = false;
+    /** The ranges from a '<' to the following '<' or '>' in the source. */
+    std::vector<std::pair<size_t, size_t>> tokens;
+    mutable std::mutex contains_mutex;
+    mutable std::unordered_map<std::string, bool> contains_cache;
+};
+
+} // namespace ert
 #endif
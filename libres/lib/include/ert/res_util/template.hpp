@@ -23,6 +23,10 @@
 
 #include <ert/res_util/subst_list.hpp>
 
+namespace ert {
+class runpath_manifest;
+}
+
 typedef struct template_struct template_type;
 
 template_type *template_alloc(const char *template_file,
@@ -32,7 +36,8 @@ void template_free(template_type *_template);
 void template_instantiate(const template_type *_template,
                           const char *__target_file,
                           const subst_list_type *arg_list,
-                          bool override_symlink);
+                          bool override_symlink,
+                          ert::runpath_manifest *manifest = NULL);
 void template_add_arg(template_type *_template, const char *key,
                       const char *value);
 subst_list_type *template_get_args_list(template_type *_template);
@@ -1,6 +1,10 @@
 #ifndef ERT_TEMPLATE_TYPE_H
 #define ERT_TEMPLATE_TYPE_H
 
+#include <memory>
+#include <mutex>
+#include <string>
+
 #include <ert/util/ert_api_config.hpp>
 
 #include <ert/res_util/subst_list.hpp>
@@ -11,6 +15,8 @@
 
 #define TEMPLATE_TYPE_ID 7781045
 
+struct template_content_struct;
+
 struct template_struct {
     UTIL_TYPE_ID_DECLARATION;
     /** The template file - if internalize_template == false this filename can
@@ -25,6 +31,11 @@ struct template_struct {
     subst_list_type *arg_list;
     /* A string representation of the arguments - ONLY used for a _get_ function. */
     char *arg_string;
+    /** The content after the substitutions of arg_list of the last
+     * instantiated template file which does not depend on the run
+     * arguments - see template_get_content(). */
+    mutable std::mutex content_mutex;
+    mutable std::shared_ptr<const template_content_struct> content_cache;
 #ifdef ERT_HAVE_REGEXP
     regex_t start_regexp;
     regex_t end_regexp;
@@ -0,0 +1,65 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'text_scanner.hpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_TEXT_SCANNER_H
+#define ERT_TEXT_SCANNER_H
+
+#include <cstddef>
+#include <string>
+
+namespace ert {
+
+/**
+ Scans the numbers and words of a text file, which is read into memory in
+ one go. A scan has the semantics of the corresponding fscanf() conversion:
+ leading whitespace is skipped, and the value ends where the conversion
+ stops, so that e.g. "1.5" scans as the int 1 followed by a failure. The line
+ and column of the position are kept for error messages.
+*/
+class text_scanner {
+public:
+    /** Reads the file filename; aborts if it can not be opened. */
+    explicit text_scanner(const char *filename);
+    /** Scans the text content; for testing. */
+    static text_scanner from_string(std::string content);
+
+    /** Skips whitespace, and returns true if nothing else is left. */
+    bool at_end();
+    /** The scans return false, and do not move, if there is no value. */
+    bool scan(int &value);
+    bool scan(float &value);
+    bool scan(double &value);
+    /** Scans the next whitespace separated word, as "%s". */
+    bool scan(std::string &word);
+    void rewind() { pos = 0; }
+
+    /** The 1-based line and column of the current position. */
+    int line() const;
+    int column() const;
+
+private:
+    text_scanner() = default;
+    void skip_space();
+
+    std::string content;
+    std::size_t pos = 0;
+};
+
+} // namespace ert
+
+#endif
@@ -16,6 +16,10 @@
    for more details.
 */
 
+#include <string>
+
+#include <fmt/format.h>
+
 #include <ert/job_queue/environment_varlist.hpp>
 
 #include <ert/res_util/res_env.hpp>
@@ -49,26 +53,31 @@ void env_varlist_setenv(env_varlist_type *list, const char *key,
     hash_insert_string(list->varlist, key, interp_value);
 }
 
-static void env_varlist_fprintf_hash(const hash_type *list,
-                                     const char *keystring, FILE *stream) {
+static std::string env_varlist_json_hash(const hash_type *list,
+                                         const char *keystring) {
     int size = hash_get_size(list);
-    fprintf(stream, "\"%s\" : {", keystring);
+    std::string json = fmt::format("\"{}\" : {{", keystring);
     stringlist_type *stringlist = hash_alloc_stringlist(list);
     int i_max = size - 1;
     for (int i = 0; i < size; i++) {
         const char *key = stringlist_iget(stringlist, i);
-        fprintf(stream, "\"%s\" : \"%s\"", key, (char *)hash_get(list, key));
+        json += fmt::format("\"{}\" : \"{}\"", key,
+                            (char *)hash_get(list, key));
         if (i < i_max)
-            fprintf(stream, ", ");
+            json += ", ";
     }
-    fprintf(stream, "}");
+    json += "}";
     stringlist_free(stringlist);
+    return json;
+}
+
+std::string env_varlist_json(const env_varlist_type *list) {
+    return env_varlist_json_hash(list->varlist, ENV_VAR_KEY_STRING) + ",\n" +
+           env_varlist_json_hash(list->updatelist, UPDATE_PATH_KEY_STRING);
 }
 
 void env_varlist_json_fprintf(const env_varlist_type *list, FILE *stream) {
-    env_varlist_fprintf_hash(list->varlist, ENV_VAR_KEY_STRING, stream);
-    fprintf(stream, ",\n");
-    env_varlist_fprintf_hash(list->updatelist, UPDATE_PATH_KEY_STRING, stream);
+    fprintf(stream, "%s", env_varlist_json(list).c_str());
 }
 
 int env_varlist_get_size(env_varlist_type *list) {
@@ -17,6 +17,9 @@
 */
 
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
 
 #include <ert/res_util/file_utils.hpp>
 #include <ert/res_util/res_env.hpp>
@@ -610,42 +613,44 @@ static char *__alloc_filtered_string(const char *src_string,
     return tmp2;
 }
 
-static void __fprintf_string(FILE *stream, const char *s,
-                             const subst_list_type *private_args,
-                             const subst_list_type *global_args) {
-    char *filtered_string =
-        __alloc_filtered_string(s, private_args, global_args);
-    fprintf(stream, "\"%s\"", filtered_string);
-    free(filtered_string);
+static std::string __alloc_private_string(const char *src_string,
+                                          const subst_list_type *private_args) {
+    char *filtered = subst_list_alloc_filtered_string(private_args, src_string);
+    std::string result = filtered;
+    free(filtered);
+    return result;
 }
 
-static void __fprintf_python_string(FILE *stream, const char *prefix,
-                                    const char *id, const char *value,
-                                    const char *suffix,
-                                    const subst_list_type *private_args,
-                                    const subst_list_type *global_args,
-                                    const char *null_value) {
-    fprintf(stream, "%s\"%s\" : ", prefix, id);
+/**
+   Appends the string filtered with the private arguments; the filtering
+   with the run arguments is done when the jobs_json is rendered, unless
+   global is false. The keys of the run arguments need not be on the <KEY>
+   form, e.g. the keys of DEFINE, so every global string is filtered.
+*/
+static void __append_python_string(ert::jobs_json &json, const char *prefix,
+                                   const char *id, const char *value,
+                                   const char *suffix,
+                                   const subst_list_type *private_args,
+                                   bool global, const char *null_value) {
+    json.append(fmt::format("{}\"{}\" : ", prefix, id));
     if (value == NULL)
-        fprintf(stream, "%s", null_value);
-    else
-        __fprintf_string(stream, value, private_args, global_args);
-    fprintf(stream, "%s", suffix);
-}
-
-static void __fprintf_init_python_list(FILE *stream, const char *id) {
-    fprintf(stream, "\"%s\" : ", id);
-    fprintf(stream, "[");
+        json.append(null_value);
+    else {
+        std::string filtered = __alloc_private_string(value, private_args);
+        if (global)
+            json.append_string(filtered.c_str());
+        else
+            json.append(fmt::format("\"{}\"", filtered));
+    }
+    json.append(suffix);
 }
 
-static void __fprintf_close_python_list(FILE *stream) { fprintf(stream, "]"); }
-
-static hash_type *__alloc_filtered_hash(hash_type *input_hash,
-                                        bool include_angular_values,
-                                        const subst_list_type *private_args,
-                                        const subst_list_type *global_args) {
-
-    hash_type *output_hash = hash_alloc();
+static void __append_python_hash(ert::jobs_json &json, const char *prefix,
+                                 const char *id, hash_type *input_hash,
+                                 const char *suffix,
+                                 const subst_list_type *private_args,
+                                 const char *null_value) {
+    ert::jobs_json::hash_entries entries;
     hash_iter_type *iter = hash_iter_alloc(input_hash);
     const char *key = hash_iter_get_next_key(iter);
     while (key != NULL) {
@@ -653,85 +658,36 @@ static hash_type *__alloc_filtered_hash(hash_type *input_hash,
         // If the value is NULL or alternatively the special string value
         // "null" we print the @null_value variable and continue.
         if (!value || strcmp(value, "null") == 0)
-            hash_insert_ref(output_hash, key, NULL);
-        else {
-            char *fv =
-                __alloc_filtered_string(value, private_args, global_args);
-            // If the value string contains a <XXX> string which is not
-            // represented in the substitutionlists we will not print out the
-            // <xxxx> literal.
-            if (include_angular_values)
-                hash_insert_hash_owned_ref(output_hash, key, fv, free);
-            else {
-                if (!(fv[0] == '<' && fv[strlen(fv) - 1] == '>'))
-                    hash_insert_hash_owned_ref(output_hash, key, fv, free);
-            }
-        }
+            entries.emplace_back(key, std::nullopt);
+        else
+            entries.emplace_back(key,
+                                 __alloc_private_string(value, private_args));
 
         key = hash_iter_get_next_key(iter);
     }
-    return output_hash;
-}
-
-static void __fprintf_python_hash(FILE *stream, const char *prefix,
-                                  const char *id, hash_type *input_hash,
-                                  const char *suffix,
-                                  const subst_list_type *private_args,
-                                  const subst_list_type *global_args,
-                                  const char *null_value) {
-    bool print_angular_values = false;
-    hash_type *output_hash = __alloc_filtered_hash(
-        input_hash, print_angular_values, private_args, global_args);
-    int hash_size = hash_get_size(output_hash);
-
-    fprintf(stream, "%s\"%s\" : ", prefix, id);
-    if (hash_size > 0) {
-        bool first = true;
-        fprintf(stream, "{");
-
-        hash_iter_type *iter = hash_iter_alloc(output_hash);
-        const char *key = hash_iter_get_next_key(iter);
-
-        while (key != NULL) {
-            const char *value = (const char *)hash_get(output_hash, key);
-            if (!first)
-                fprintf(stream, ",");
+    hash_iter_free(iter);
 
-            if (value)
-                fprintf(stream, "\"%s\" : \"%s\"", key, value);
-            else
-                fprintf(stream, "\"%s\" : %s", key, null_value);
-
-            key = hash_iter_get_next_key(iter);
-            first = false;
-        }
-
-        fprintf(stream, "}");
-    } else
-        fprintf(stream, "%s", null_value);
-    fprintf(stream, "%s", suffix);
-
-    hash_free(output_hash);
+    json.append(fmt::format("{}\"{}\" : ", prefix, id));
+    json.append_hash(std::move(entries), null_value);
+    json.append(suffix);
 }
 
-static void __fprintf_python_int(FILE *stream, const char *prefix,
-                                 const char *key, int value, const char *suffix,
-                                 const char *null_value) {
-    fprintf(stream, "%s", prefix);
+static void __append_python_int(ert::jobs_json &json, const char *prefix,
+                                const char *key, int value, const char *suffix,
+                                const char *null_value) {
     if (value > 0)
-        fprintf(stream, "\"%s\" : %d", key, value);
+        json.append(fmt::format("{}\"{}\" : {}{}", prefix, key, value, suffix));
     else
-        fprintf(stream, "\"%s\" : %s", key, null_value);
-    fprintf(stream, "%s", suffix);
+        json.append(
+            fmt::format("{}\"{}\" : {}{}", prefix, key, null_value, suffix));
 }
 
 /**
    This is special cased to support the default mapping.
 */
-static void __fprintf_python_argList(FILE *stream, const char *prefix,
-                                     const ext_job_type *ext_job,
-                                     const char *suffix,
-                                     const subst_list_type *global_args) {
+static void __append_python_argList(ert::jobs_json &json, const char *prefix,
+                                    const ext_job_type *ext_job,
+                                    const char *suffix) {
 
     stringlist_type *argv;
     if (ext_job->deprecated_argv)
@@ -739,42 +695,43 @@ static void __fprintf_python_argList(FILE *stream, const char *prefix,
     else
         argv = ext_job->argv;
 
-    fprintf(stream, "%s", prefix);
-    __fprintf_init_python_list(stream, "argList");
+    auto mapping = std::make_shared<ert::jobs_json::default_mapping>();
     {
-        for (int index = 0; index < stringlist_get_size(argv); index++) {
-            const char *src_string = stringlist_iget(argv, index);
-            char *filtered_string = __alloc_filtered_string(
-                src_string, ext_job->private_args, global_args);
-            if (hash_has_key(ext_job->default_mapping, filtered_string))
-                filtered_string = (char *)util_realloc_string_copy(
-                    filtered_string,
-                    (const char *)hash_get(ext_job->default_mapping,
-                                           filtered_string));
-
-            fprintf(stream, "\"%s\"", filtered_string);
-            if (index < (stringlist_get_size(argv) - 1))
-                fprintf(stream, ",");
-
-            free(filtered_string);
+        hash_iter_type *iter = hash_iter_alloc(ext_job->default_mapping);
+        const char *key = hash_iter_get_next_key(iter);
+        while (key != NULL) {
+            (*mapping)[key] =
+                (const char *)hash_get(ext_job->default_mapping, key);
+            key = hash_iter_get_next_key(iter);
         }
+        hash_iter_free(iter);
+    }
+
+    json.append(fmt::format("{}\"argList\" : [", prefix));
+    for (int index = 0; index < stringlist_get_size(argv); index++) {
+        const char *src_string = stringlist_iget(argv, index);
+        json.append_argument(
+            __alloc_private_string(src_string, ext_job->private_args).c_str(),
+            mapping);
+        if (index < (stringlist_get_size(argv) - 1))
+            json.append(",");
     }
-    __fprintf_close_python_list(stream);
-    fprintf(stream, "%s", suffix);
+    json.append("]");
+    json.append(suffix);
 }
 
-static void __fprintf_python_arg_types(FILE *stream, const char *prefix,
-                                       const char *key,
-                                       const ext_job_type *ext_job,
-                                       const char *suffix,
-                                       const char *null_value) {
-    fprintf(stream, "%s", prefix);
+static void __append_python_arg_types(ert::jobs_json &json, const char *prefix,
+                                      const char *key,
+                                      const ext_job_type *ext_job,
+                                      const char *suffix,
+                                      const char *null_value) {
+    json.append(prefix);
     if (!ext_job->arg_types) {
-        fprintf(stream, "\"%s\" : %s", key, null_value);
-        goto postfix;
+        json.append(fmt::format("\"{}\" : {}{}", key, null_value, suffix));
+        return;
     }
 
-    fprintf(stream, "\"%s\" : [", key);
+    json.append(fmt::format("\"{}\" : [", key));
     for (int i = 0; i < ext_job->max_arg; i++) {
 
         const char *arg_type = NULL;
@@ -802,82 +759,82 @@ static void __fprintf_python_arg_types(FILE *stream, const char *prefix,
             util_abort("%s unknown config type %d", __func__, type);
         }
 
-        fprintf(stream, "\"%s\"", arg_type);
+        json.append(fmt::format("\"{}\"", arg_type));
         if ((i + 1) < ext_job->max_arg)
-            fprintf(stream, ", ");
+            json.append(", ");
     }
-    fprintf(stream, "]");
-
-postfix:
-    fprintf(stream, "%s", suffix);
+    json.append("]");
+    json.append(suffix);
 }
 
-void ext_job_json_fprintf(const ext_job_type *ext_job, int job_index,
-                          FILE *stream, const subst_list_type *global_args) {
+/**
+   Appends the json description of the job to json; the strings which are
+   filtered with the run arguments are slots of json.
+*/
+void ext_job_json_append(const ext_job_type *ext_job, int job_index,
+                         ert::jobs_json &json) {
     const char *null_value = "null";
+    const subst_list_type *private_args = ext_job->private_args;
 
-    char *file_stdout_index = NULL;
-    char *file_stderr_index = NULL;
-
-    file_stdout_index =
+    char *file_stdout_index =
         util_alloc_sprintf("%s.%d", ext_job->stdout_file, job_index);
-    file_stderr_index =
+    char *file_stderr_index =
         util_alloc_sprintf("%s.%d", ext_job->stderr_file, job_index);
 
-    fprintf(stream, " {");
+    json.append(" {");
     {
-        __fprintf_python_string(stream, "", "name", ext_job->name, ",\n",
-                                ext_job->private_args, NULL, null_value);
-        __fprintf_python_string(stream, "  ", "executable", ext_job->executable,
-                                ",\n", ext_job->private_args, global_args,
-                                null_value);
-        __fprintf_python_string(stream, "  ", "target_file",
-                                ext_job->target_file, ",\n",
-                                ext_job->private_args, global_args, null_value);
-        __fprintf_python_string(stream, "  ", "error_file", ext_job->error_file,
-                                ",\n", ext_job->private_args, global_args,
-                                null_value);
-        __fprintf_python_string(stream, "  ", "start_file", ext_job->start_file,
-                                ",\n", ext_job->private_args, global_args,
-                                null_value);
-        __fprintf_python_string(stream, "  ", "stdout", file_stdout_index,
-                                ",\n", ext_job->private_args, global_args,
-                                null_value);
-        __fprintf_python_string(stream, "  ", "stderr", file_stderr_index,
-                                ",\n", ext_job->private_args, global_args,
-                                null_value);
-        __fprintf_python_string(stream, "  ", "stdin", ext_job->stdin_file,
-                                ",\n", ext_job->private_args, global_args,
-                                null_value);
-        __fprintf_python_argList(stream, "  ", ext_job, ",\n", global_args);
-        __fprintf_python_hash(stream, "  ", "environment", ext_job->environment,
-                              ",\n", ext_job->private_args, global_args,
-                              null_value);
-        __fprintf_python_hash(stream, "  ", "exec_env", ext_job->exec_env,
-                              ",\n", ext_job->private_args, global_args,
-                              null_value);
-        __fprintf_python_string(stream, "  ", "license_path",
-                                ext_job->license_path, ",\n",
-                                ext_job->private_args, global_args, null_value);
-        __fprintf_python_int(stream, "  ", "max_running_minutes",
-                             ext_job->max_running_minutes, ",\n", null_value);
-        __fprintf_python_int(stream, "  ", "max_running", ext_job->max_running,
-                             ",\n", null_value);
-        __fprintf_python_int(stream, "  ", "min_arg", ext_job->min_arg, ",\n",
-                             null_value);
-
-        __fprintf_python_arg_types(stream, "  ", "arg_types", ext_job, ",\n",
-                                   null_value);
-
-        __fprintf_python_int(stream, "  ", "max_arg", ext_job->max_arg, "\n",
-                             null_value);
+        __append_python_string(json, "", "name", ext_job->name, ",\n",
+                               private_args, false, null_value);
+        __append_python_string(json, "  ", "executable", ext_job->executable,
+                               ",\n", private_args, true, null_value);
+        __append_python_string(json, "  ", "target_file",
+                               ext_job->target_file, ",\n", private_args, true,
+                               null_value);
+        __append_python_string(json, "  ", "error_file", ext_job->error_file,
+                               ",\n", private_args, true, null_value);
+        __append_python_string(json, "  ", "start_file", ext_job->start_file,
+                               ",\n", private_args, true, null_value);
+        __append_python_string(json, "  ", "stdout", file_stdout_index,
+                               ",\n", private_args, true, null_value);
+        __append_python_string(json, "  ", "stderr", file_stderr_index,
+                               ",\n", private_args, true, null_value);
+        __append_python_string(json, "  ", "stdin", ext_job->stdin_file,
+                               ",\n", private_args, true, null_value);
+        __append_python_argList(json, "  ", ext_job, ",\n");
+        __append_python_hash(json, "  ", "environment", ext_job->environment,
+                             ",\n", private_args, null_value);
+        __append_python_hash(json, "  ", "exec_env", ext_job->exec_env, ",\n",
+                             private_args, null_value);
+        __append_python_string(json, "  ", "license_path",
+                               ext_job->license_path, ",\n", private_args,
+                               true, null_value);
+        __append_python_int(json, "  ", "max_running_minutes",
+                            ext_job->max_running_minutes, ",\n", null_value);
+        __append_python_int(json, "  ", "max_running", ext_job->max_running,
+                            ",\n", null_value);
+        __append_python_int(json, "  ", "min_arg", ext_job->min_arg, ",\n",
+                            null_value);
+
+        __append_python_arg_types(json, "  ", "arg_types", ext_job, ",\n",
+                                  null_value);
+
+        __append_python_int(json, "  ", "max_arg", ext_job->max_arg, "\n",
+                            null_value);
     }
-    fprintf(stream, "}");
+    json.append("}");
 
     free(file_stdout_index);
     free(file_stderr_index);
 }
 
+void ext_job_json_fprintf(const ext_job_type *ext_job, int job_index,
+                          FILE *stream, const subst_list_type *global_args) {
+    ert::jobs_json json;
+    ext_job_json_append(ext_job, job_index, json);
+    std::string text = json.render(global_args);
+    fwrite(text.data(), 1, text.size(), stream);
+}
+
 #define PRINT_KEY_STRING(stream, key, value)                                   \
     if (value != NULL) {                                                       \
         fprintf(stream, "%16s ", key);                                         \
@@ -21,6 +21,9 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <string>
+
+#include <ert/res_util/runpath_manifest.hpp>
 #include <ert/res_util/subst_list.hpp>
 #include <ert/util/parser.hpp>
 #include <ert/util/util.hpp>
@@ -156,38 +159,62 @@ void forward_model_parse_job_deprecated_args(
     free(job_name);
 }
 
-static void forward_model_json_fprintf(const forward_model_type *forward_model,
-                                       const char *run_id, const char *path,
-                                       const char *data_root,
-                                       const subst_list_type *global_args,
-                                       mode_t umask,
-                                       const env_varlist_type *varlist) {
-    char *json_file = (char *)util_alloc_filename(path, DEFAULT_JOB_JSON, NULL);
-    FILE *stream = util_fopen(json_file, "w");
-    int job_index;
-
-    fprintf(stream, "{\n");
-
-    fprintf(stream, "\"umask\" : \"%04o\",\n", umask);
-    fprintf(stream, "\"DATA_ROOT\": \"%s\",\n", data_root);
-    env_varlist_json_fprintf(varlist, stream);
-    fprintf(stream, ",\n");
-    fprintf(stream, "\"jobList\" : [");
-    for (job_index = 0; job_index < vector_get_size(forward_model->jobs);
+/**
+   Compiles the jobs.json content of the forward model for the run run_id;
+   only the strings which are filtered with the run arguments of a
+   realization are left to forward_model_json_fwrite().
+*/
+ert::jobs_json
+forward_model_compile_json(const forward_model_type *forward_model,
+                           const char *run_id, const char *data_root,
+                           mode_t umask, const env_varlist_type *varlist) {
+    ert::jobs_json json;
+    char *header = util_alloc_sprintf("{\n"
+                                      "\"umask\" : \"%04o\",\n"
+                                      "\"DATA_ROOT\": \"%s\",\n",
+                                      umask, data_root);
+    json.append(header);
+    free(header);
+    json.append(env_varlist_json(varlist));
+    json.append(",\n");
+    json.append("\"jobList\" : [");
+    for (int job_index = 0; job_index < vector_get_size(forward_model->jobs);
          job_index++) {
         const ext_job_type *job = (const ext_job_type *)vector_iget_const(
             forward_model->jobs, job_index);
-        ext_job_json_fprintf(job, job_index, stream, global_args);
+        ext_job_json_append(job, job_index, json);
         if (job_index < (vector_get_size(forward_model->jobs) - 1))
-            fprintf(stream, ",\n");
+            json.append(",\n");
     }
-    fprintf(stream, "],\n");
+    json.append("],\n");
+
+    char *trailer = util_alloc_sprintf("\"run_id\" : \"%s\",\n"
+                                       "\"ert_pid\" : \"%ld\"\n"
+                                       "}\n",
+                                       run_id, (long)getpid());
+    json.append(trailer);
+    free(trailer);
+    return json;
+}
 
-    fprintf(stream, "\"run_id\" : \"%s\",\n", run_id);
-    fprintf(stream, "\"ert_pid\" : \"%ld\"\n",
-            (long)getpid()); //Long is big enough to hold __pid_t
-    fprintf(stream, "}\n");
-    fclose(stream);
+/**
+   Writes the jobs.json file of a realization in path, with the slots of
+   json filled from the run arguments global_args. With a manifest the
+   file is only written if its content has changed.
+*/
+void forward_model_json_fwrite(const ert::jobs_json &json, const char *path,
+                               const subst_list_type *global_args,
+                               ert::runpath_manifest *manifest) {
+    char *json_file = (char *)util_alloc_filename(path, DEFAULT_JOB_JSON, NULL);
+    std::string text = json.render(global_args);
+    if (manifest) {
+        if (!manifest->write_file(json_file, {text}))
+            util_abort("%s: failed to write:%s \n", __func__, json_file);
+    } else {
+        FILE *stream = util_fopen(json_file, "w");
+        fwrite(text.data(), 1, text.size(), stream);
+        fclose(stream);
+    }
     free(json_file);
 
     char *status_file =
@@ -202,8 +229,10 @@ void forward_model_formatted_fprintf(const forward_model_type *forward_model,
                                      const subst_list_type *global_args,
                                      mode_t umask,
                                      const env_varlist_type *list) {
-    forward_model_json_fprintf(forward_model, run_id, path, data_root,
-                               global_args, umask, list);
+    forward_model_json_fwrite(
+        forward_model_compile_json(forward_model, run_id, data_root, umask,
+                                   list),
+        path, global_args);
 }
 
 #undef DEFAULT_JOB_JSON
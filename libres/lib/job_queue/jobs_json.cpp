@@ -0,0 +1,128 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'jobs_json.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+
+#include <ert/util/hash.hpp>
+#include <ert/util/util.hpp>
+
+#include <ert/job_queue/jobs_json.hpp>
+
+namespace {
+std::string filter(const subst_list_type *global_args,
+                   const std::string &value) {
+    if (global_args == NULL)
+        return value;
+
+    char *filtered =
+        subst_list_alloc_filtered_string(global_args, value.c_str());
+    std::string result = filtered;
+    free(filtered);
+    return result;
+}
+} // namespace
+
+namespace ert {
+
+void jobs_json::append(std::string_view text) {
+    if (segments.empty() || segments.back().type != slot_type::text)
+        segments.push_back({slot_type::text, "", nullptr, {}});
+    segments.back().text.append(text);
+}
+
+void jobs_json::append_string(const char *value) {
+    segments.push_back({slot_type::string, value, nullptr, {}});
+}
+
+void jobs_json::append_argument(
+    const char *value, std::shared_ptr<const default_mapping> mapping) {
+    segments.push_back({slot_type::argument, value, std::move(mapping), {}});
+}
+
+void jobs_json::append_hash(hash_entries entries, const char *null_value) {
+    segments.push_back(
+        {slot_type::hash, null_value, nullptr, std::move(entries)});
+}
+
+std::string jobs_json::render(const subst_list_type *global_args) const {
+    std::string json;
+    for (const auto &segment : segments) {
+        switch (segment.type) {
+        case slot_type::text:
+            json += segment.text;
+            break;
+        case slot_type::string:
+            json += '"' + filter(global_args, segment.text) + '"';
+            break;
+        case slot_type::argument: {
+            std::string value = filter(global_args, segment.text);
+            auto mapped = segment.mapping->find(value);
+            if (mapped != segment.mapping->end())
+                value = mapped->second;
+            json += '"' + value + '"';
+            break;
+        }
+        case slot_type::hash: {
+            // The values are inserted in a hash, as the hash is printed in
+            // its own iteration order.
+            hash_type *hash = hash_alloc();
+            for (const auto &[key, value] : segment.entries) {
+                if (!value) {
+                    hash_insert_ref(hash, key.c_str(), NULL);
+                    continue;
+                }
+
+                std::string filtered = filter(global_args, *value);
+                if (!filtered.empty() && filtered[0] == '<' &&
+                    filtered.back() == '>')
+                    continue;
+                hash_insert_hash_owned_ref(
+                    hash, key.c_str(),
+                    util_alloc_string_copy(filtered.c_str()), free);
+            }
+
+            if (hash_get_size(hash) > 0) {
+                bool first = true;
+                json += '{';
+                hash_iter_type *iter = hash_iter_alloc(hash);
+                const char *key = hash_iter_get_next_key(iter);
+                while (key != NULL) {
+                    const char *value = (const char *)hash_get(hash, key);
+                    if (!first)
+                        json += ',';
+                    json += '"' + std::string(key) + "\" : ";
+                    if (value)
+                        json += '"' + std::string(value) + '"';
+                    else
+                        json += segment.text;
+                    key = hash_iter_get_next_key(iter);
+                    first = false;
+                }
+                hash_iter_free(iter);
+                json += '}';
+            } else
+                json += segment.text;
+            hash_free(hash);
+            break;
+        }
+        }
+    }
+    return json;
+}
+
+} // namespace ert
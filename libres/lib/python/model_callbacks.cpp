@@ -1,3 +1,4 @@
+#include <ert/enkf/load_service.hpp>
 #include <ert/enkf/res_config.hpp>
 #include <ert/enkf/run_arg.hpp>
 #include <ert/python.hpp>
@@ -8,9 +9,15 @@ RES_LIB_SUBMODULE("model_callbacks", m) {
         return enkf_state_complete_forward_model_EXIT_handler__(run_arg);
     });
 
+    // The results are loaded by the load service without holding the GIL,
+    // so the other Python threads keep running while a realization loads;
+    // the callers bound how many callbacks run at the same time.
     m.def("forward_model_ok", [](std::vector<py::object> arr) {
         auto run_arg = ert::from_cwrap<run_arg_type>(arr[0]);
         const auto res_conf = ert::from_cwrap<res_config_type>(arr[1]);
-        return enkf_state_complete_forward_modelOK(res_conf, run_arg);
+        auto result = ert::load_service::instance().submit(res_conf, run_arg);
+
+        py::gil_scoped_release release;
+        return result.get();
     });
 }
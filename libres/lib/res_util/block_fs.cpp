@@ -16,6 +16,7 @@
    for more details.
 */
 
+#include <algorithm>
 #include <filesystem>
 #include <mutex>
 #include <stdexcept>
@@ -55,6 +56,14 @@ namespace fs = std::filesystem;
 
 #define DEFAULT_INDEX_SIZE 2048
 
+/*
+   block_fs_fread_files() reads files which are at most MAX_READ_GAP bytes
+   apart in the data file with one fread(), as long as the read is at most
+   MAX_READ_SPAN bytes.
+*/
+#define MAX_READ_GAP 4096
+#define MAX_READ_SPAN (16 << 20)
+
 /*
    These should be bitwise "smart" - so it is possible
    to go on a wild chase through a binary stream and look for them.
@@ -617,6 +626,20 @@ bool block_fs_has_file(block_fs_type *block_fs, const char *filename) {
     return block_fs_has_file__(block_fs, filename);
 }
 
+/**
+   Checks for the existence of several files while holding the lock only
+   once; element i in the return value corresponds to filenames[i].
+*/
+std::vector<bool>
+block_fs_has_files(block_fs_type *block_fs,
+                   const std::vector<std::string> &filenames) {
+    std::vector<bool> has_file(filenames.size());
+    std::lock_guard guard{block_fs->mutex};
+    for (size_t i = 0; i < filenames.size(); i++)
+        has_file[i] = block_fs_has_file__(block_fs, filenames[i].c_str());
+    return has_file;
+}
+
 /**
    It seems it is not enough to call fsync(); must also issue this
    funny fseek + ftell combination to ensure that all data is on
@@ -717,6 +740,88 @@ void block_fs_fread_realloc_buffer(block_fs_type *block_fs,
     buffer_rewind(buffer); /* Setting: pos = 0; */
 }
 
+/**
+   Reads the full content of several files while holding the lock only once;
+   element i in the return value tells whether filenames[i] exists, and its
+   content is then read into buffers[i]. The files are read in the order of
+   their offset in the data file, and the files which are close to each
+   other are read together; see MAX_READ_GAP.
+*/
+std::vector<bool>
+block_fs_fread_files(block_fs_type *block_fs,
+                     const std::vector<std::string> &filenames,
+                     const std::vector<buffer_type *> &buffers) {
+    std::vector<bool> has_file(filenames.size());
+    std::vector<std::pair<const file_node_type *, size_t>> nodes;
+    std::lock_guard guard{block_fs->mutex};
+    for (size_t i = 0; i < filenames.size(); i++) {
+        if (!block_fs_has_file__(block_fs, filenames[i].c_str()))
+            continue;
+        nodes.emplace_back(
+            (const file_node_type *)hash_get(block_fs->index,
+                                             filenames[i].c_str()),
+            i);
+        has_file[i] = true;
+    }
+    std::sort(nodes.begin(), nodes.end(), [](const auto &a, const auto &b) {
+        return a.first->node_offset < b.first->node_offset;
+    });
+
+    auto data_start = [](const file_node_type *node) {
+        return node->node_offset + node->data_offset;
+    };
+    std::vector<char> span;
+    size_t begin = 0;
+    while (begin < nodes.size()) {
+        long start = data_start(nodes[begin].first);
+        long stop = start + nodes[begin].first->data_size;
+        size_t end = begin + 1;
+        for (; end < nodes.size(); end++) {
+            const file_node_type *node = nodes[end].first;
+            if (data_start(node) - stop > MAX_READ_GAP ||
+                data_start(node) + node->data_size - start > MAX_READ_SPAN)
+                break;
+            stop = data_start(node) + node->data_size;
+        }
+
+        span.resize(stop - start);
+        block_fs_fseek(block_fs, start);
+        util_fread(span.data(), 1, span.size(), block_fs->data_stream,
+                   __func__);
+        for (size_t inode = begin; inode < end; inode++) {
+            const auto &[node, index] = nodes[inode];
+            buffer_type *buffer = buffers[index];
+            buffer_clear(buffer);
+            buffer_fwrite(buffer, span.data() + (data_start(node) - start), 1,
+                          node->data_size);
+            buffer_rewind(buffer);
+        }
+        begin = end;
+    }
+    return has_file;
+}
+
+/**
+   Reads byte_size bytes, starting at offset into the content of 'filename',
+   into ptr. This allows a part of a large file to be read without loading
+   all of it.
+*/
+void block_fs_fread_range(block_fs_type *block_fs, const char *filename,
+                          size_t offset, void *ptr, size_t byte_size) {
+    std::lock_guard guard{block_fs->mutex};
+    file_node_type *node =
+        (file_node_type *)hash_get(block_fs->index, filename);
+
+    if (offset + byte_size > (size_t)node->data_size)
+        util_abort("%s: can not read %zu bytes at offset %zu from %s which "
+                   "has size %d\n",
+                   __func__, byte_size, offset, filename, node->data_size);
+
+    block_fs_fseek(block_fs,
+                   node->node_offset + node->data_offset + (long)offset);
+    util_fread(ptr, 1, byte_size, block_fs->data_stream, __func__);
+}
+
 /**
    Close/synchronize the open file descriptors and free all memory
    related to the block_fs instance.
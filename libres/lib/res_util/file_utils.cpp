@@ -1,4 +1,17 @@
+#include <algorithm>
 #include <filesystem>
+#include <system_error>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
 
 #include <ert/res_util/file_utils.hpp>
 
@@ -13,3 +26,85 @@ FILE *mkdir_fopen(fs::path file_path, const char *mode) {
     FILE *stream = fopen(full_path.c_str(), mode);
     return stream;
 }
+
+bool clone_file(const fs::path &source_file, const fs::path &target_file) {
+    std::error_code ec;
+    auto directory = target_file.parent_path();
+    if (!directory.empty())
+        fs::create_directories(directory, ec);
+
+#ifdef FICLONE
+    int source = open(source_file.c_str(), O_RDONLY);
+    if (source < 0)
+        return false;
+
+    int target = open(target_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    bool cloned = target >= 0 && ioctl(target, FICLONE, source) == 0;
+    if (target >= 0)
+        close(target);
+    close(source);
+    return cloned;
+#else
+    return false;
+#endif
+}
+
+bool write_file_spans(const fs::path &target_file,
+                      const std::vector<std::string_view> &spans) {
+    std::error_code ec;
+    auto directory = target_file.parent_path();
+    if (!directory.empty())
+        fs::create_directories(directory, ec);
+
+    int target = open(target_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (target < 0)
+        return false;
+
+    std::vector<struct iovec> iov;
+    for (auto span : spans) {
+        if (!span.empty())
+            iov.push_back({const_cast<char *>(span.data()), span.size()});
+    }
+
+    bool written = true;
+    size_t index = 0;
+    while (index < iov.size()) {
+        int count = std::min<size_t>(iov.size() - index, IOV_MAX);
+        ssize_t bytes = writev(target, iov.data() + index, count);
+        if (bytes < 0) {
+            if (errno == EINTR)
+                continue;
+            written = false;
+            break;
+        }
+
+        // Skips the spans which are written, and the written part of the
+        // span where a short write stopped.
+        while (index < iov.size() && (size_t)bytes >= iov[index].iov_len) {
+            bytes -= iov[index].iov_len;
+            index++;
+        }
+        if (bytes > 0) {
+            iov[index].iov_base =
+                static_cast<char *>(iov[index].iov_base) + bytes;
+            iov[index].iov_len -= bytes;
+        }
+    }
+    if (close(target) != 0)
+        written = false;
+    return written;
+}
+
+uint64_t hash_bytes(uint64_t hash, const char *data, size_t size) {
+    const uint64_t hash_prime = 0x100000001b3;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof word);
+        hash = (hash ^ word) * hash_prime;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; i++)
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * hash_prime;
+    return hash;
+}
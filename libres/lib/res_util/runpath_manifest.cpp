@@ -0,0 +1,189 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'runpath_manifest.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include <ert/res_util/file_utils.hpp>
+#include <ert/res_util/runpath_manifest.hpp>
+
+namespace fs = std::filesystem;
+
+namespace {
+const char *const manifest_header = "ERT_RUNPATH_MANIFEST 1";
+
+/**
+   hash_bytes() of the concatenation of spans. It takes eight bytes at a
+   time, so the bytes at the end of a span are carried over to the next.
+*/
+uint64_t hash_spans(const std::vector<std::string_view> &spans) {
+    uint64_t hash = hash_bytes_seed;
+    char carry[sizeof(uint64_t)];
+    size_t carried = 0;
+    for (auto span : spans) {
+        if (carried > 0) {
+            size_t count = std::min(sizeof carry - carried, span.size());
+            memcpy(carry + carried, span.data(), count);
+            carried += count;
+            span.remove_prefix(count);
+            if (carried < sizeof carry)
+                continue;
+            hash = hash_bytes(hash, carry, carried);
+            carried = 0;
+        }
+
+        size_t words = span.size() - span.size() % sizeof carry;
+        hash = hash_bytes(hash, span.data(), words);
+        carried = span.size() - words;
+        memcpy(carry, span.data() + words, carried);
+    }
+    return hash_bytes(hash, carry, carried);
+}
+
+/** Returns false if file does not exist. */
+bool file_status(const fs::path &file, int64_t &size, int64_t &mtime) {
+    std::error_code ec;
+    auto file_size = fs::file_size(file, ec);
+    if (ec)
+        return false;
+    auto write_time = fs::last_write_time(file, ec);
+    if (ec)
+        return false;
+
+    size = file_size;
+    mtime = write_time.time_since_epoch().count();
+    return true;
+}
+} // namespace
+
+ert::runpath_manifest::runpath_manifest(const fs::path &runpath)
+    : runpath(runpath) {
+    std::ifstream stream(runpath / filename);
+    std::string line;
+    if (!std::getline(stream, line) || line != manifest_header)
+        return;
+
+    // Each line is: hash size mtime file
+    while (std::getline(stream, line)) {
+        entry file_entry;
+        int offset = 0;
+        if (sscanf(line.c_str(), "%" SCNx64 " %" SCNd64 " %" SCNd64 " %n",
+                   &file_entry.hash, &file_entry.size, &file_entry.mtime,
+                   &offset) != 3 ||
+            offset == 0) {
+            entries.clear();
+            return;
+        }
+        entries[line.substr(offset)] = file_entry;
+    }
+}
+
+std::string ert::runpath_manifest::key(const fs::path &file) const {
+    auto normal_file = file.lexically_normal();
+    auto relative = normal_file.lexically_relative(runpath.lexically_normal());
+    return relative.empty() ? normal_file.string() : relative.string();
+}
+
+bool ert::runpath_manifest::has_content(const fs::path &file,
+                                        uint64_t hash) const {
+    auto iter = entries.find(key(file));
+    if (iter == entries.end() || iter->second.hash != hash)
+        return false;
+
+    int64_t size;
+    int64_t mtime;
+    return file_status(file, size, mtime) && size == iter->second.size &&
+           mtime == iter->second.mtime;
+}
+
+void ert::runpath_manifest::set_entry(const fs::path &file, uint64_t hash) {
+    entry file_entry{hash, 0, 0};
+    if (file_status(file, file_entry.size, file_entry.mtime)) {
+        entries[key(file)] = file_entry;
+        modified = true;
+    } else
+        erase(file);
+}
+
+bool ert::runpath_manifest::unchanged(
+    const fs::path &file, const std::vector<std::string_view> &spans) const {
+    return has_content(file, hash_spans(spans));
+}
+
+bool ert::runpath_manifest::write_file(
+    const fs::path &file, const std::vector<std::string_view> &spans) {
+    uint64_t hash = hash_spans(spans);
+    if (has_content(file, hash))
+        return true;
+
+    if (!write_file_spans(file, spans)) {
+        erase(file);
+        return false;
+    }
+    set_entry(file, hash);
+    return true;
+}
+
+void ert::runpath_manifest::add_file(
+    const fs::path &file, const std::vector<std::string_view> &spans) {
+    set_entry(file, hash_spans(spans));
+}
+
+void ert::runpath_manifest::erase(const fs::path &file) {
+    if (entries.erase(key(file)) > 0)
+        modified = true;
+}
+
+void ert::runpath_manifest::save() {
+    if (!modified)
+        return;
+
+    // The manifest is replaced in one go, a manifest which can not be
+    // written only means that the files are written again.
+    fs::path manifest_file = runpath / filename;
+    fs::path tmp_file = manifest_file;
+    tmp_file += ".tmp";
+    std::error_code ec;
+    {
+        std::ofstream stream(tmp_file);
+        stream << manifest_header << '\n';
+        for (const auto &[file, file_entry] : entries) {
+            if (file.find('\n') == std::string::npos)
+                stream << fmt::format("{:x} {} {} {}\n", file_entry.hash,
+                                      file_entry.size, file_entry.mtime,
+                                      file);
+        }
+        if (!stream) {
+            stream.close();
+            fs::remove(tmp_file, ec);
+            return;
+        }
+    }
+
+    fs::rename(tmp_file, manifest_file, ec);
+    if (ec)
+        fs::remove(tmp_file, ec);
+    else
+        modified = false;
+}
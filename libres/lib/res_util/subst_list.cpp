@@ -16,13 +16,26 @@
    for more details.
 */
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include <ert/res_util/file_utils.hpp>
+#include <ert/res_util/runpath_manifest.hpp>
 #include <ert/util/buffer.hpp>
 #include <ert/util/hash.hpp>
 #include <ert/util/parser.hpp>
@@ -83,6 +96,10 @@ typedef enum {
 
 #define SUBST_LIST_TYPE_ID 6614320
 
+namespace {
+class subst_matcher;
+}
+
 struct subst_list_struct {
     UTIL_TYPE_ID_DECLARATION;
     /** A parent subst_list instance - can be NULL - no destructor is called
@@ -95,6 +112,12 @@ struct subst_list_struct {
     /** NOT owned by the subst_list instance - can be NULL */
     const subst_func_pool_type *func_pool;
     hash_type *map;
+    /** Updated when the substitutions, or the parent, change - see
+     * subst_list_touch(). */
+    long version;
+    /** The compiled string substitutions - see subst_list_get_matcher(). */
+    mutable std::mutex matcher_mutex;
+    mutable std::shared_ptr<const subst_matcher> matcher;
 };
 
 typedef struct {
@@ -241,6 +264,28 @@ subst_list_insert_new_node(subst_list_type *subst_list, const char *key,
 
 UTIL_IS_INSTANCE_FUNCTION(subst_list, SUBST_LIST_TYPE_ID)
 
+/**
+   The versions are taken from one counter for all the instances, so that
+   the largest version of a subst_list and its parents changes whenever
+   one of them changes.
+*/
+static void subst_list_touch(subst_list_type *subst_list) {
+    static std::atomic<long> versions{0};
+    subst_list->version = ++versions;
+}
+
+/**
+   Returns a number which changes when the substitutions or functions of
+   subst_list, or one of its parents, change; changes to the content of
+   the values which are inserted as shared references are not seen.
+*/
+long subst_list_get_version(const subst_list_type *subst_list) {
+    long version = subst_list->version;
+    for (auto list = subst_list->parent; list != NULL; list = list->parent)
+        version = std::max(version, list->version);
+    return version;
+}
+
 /**
    Observe that this function sets both the subst parent, and the pool
    of available functions. If this is call is repeated it is possible
@@ -251,6 +296,7 @@ UTIL_IS_INSTANCE_FUNCTION(subst_list, SUBST_LIST_TYPE_ID)
 void subst_list_set_parent(subst_list_type *subst_list,
                            const subst_list_type *parent) {
     subst_list->parent = parent;
+    subst_list_touch(subst_list);
     if (parent != NULL)
         subst_list->func_pool = subst_list->parent->func_pool;
 }
@@ -271,9 +317,9 @@ bool subst_list_has_key(const subst_list_type *subst_list, const char *key) {
    instance.
 */
 subst_list_type *subst_list_alloc(const void *input_arg) {
-    subst_list_type *subst_list =
-        (subst_list_type *)util_malloc(sizeof *subst_list);
+    subst_list_type *subst_list = new subst_list_type();
     UTIL_TYPE_ID_INIT(subst_list, SUBST_LIST_TYPE_ID);
+    subst_list_touch(subst_list);
     subst_list->parent = NULL;
     subst_list->func_pool = NULL;
     subst_list->map = hash_alloc();
@@ -315,6 +361,7 @@ static void subst_list_insert__(subst_list_type *subst_list, const char *key,
     if (node == NULL) /* Did not have the node. */
         node = subst_list_insert_new_node(subst_list, key, append);
     subst_list_string_set_value(node, value, doc_string, insert_mode);
+    subst_list_touch(subst_list);
 }
 
 /*
@@ -385,19 +432,21 @@ void subst_list_insert_func(subst_list_type *subst_list, const char *func_name,
             subst_func_pool_get_func(subst_list->func_pool, func_name));
         vector_append_owned_ref(subst_list->func_data, subst_func,
                                 subst_list_func_free__);
+        subst_list_touch(subst_list);
     } else
         util_abort("%s: function:%s not available \n", __func__, func_name);
 }
 
 void subst_list_clear(subst_list_type *subst_list) {
     vector_clear(subst_list->string_data);
+    subst_list_touch(subst_list);
 }
 
 void subst_list_free(subst_list_type *subst_list) {
     vector_free(subst_list->string_data);
     vector_free(subst_list->func_data);
     hash_free(subst_list->map);
-    free(subst_list);
+    delete subst_list;
 }
 
 /*
@@ -611,17 +660,207 @@ static bool subst_list_replace_strings(const subst_list_type *subst_list,
     return match;
 }
 
+namespace {
+
+bool is_magic_string(std::string_view key) {
+    return key.size() >= 2 && key.front() == '<' && key.back() == '>' &&
+           key.substr(1, key.size() - 2).find_first_of("<>") ==
+               std::string_view::npos;
+}
+
+/**
+   The string substitutions of a subst_list and its parents, compiled to
+   replace all the keys in one pass over the text, instead of one pass for
+   each key as in subst_list_replace_strings().
+
+   This gives the same result as the passes when all the keys are magic
+   strings "<KEY>", without '<' or '>' inside, and none of the values
+   which are inserted contain '<' or '>': the keys can then not overlap in
+   the text, and they are replaced where they occur in the input - with
+   the value of the first (key, value) pair in the top down order. The
+   only exception is a key which is joined by the passes, as "<A" +
+   "<B>" + ">" with "<B>" replaced by "B"; this can only happen for a '<'
+   followed by a prefix of a key and another '<'. The matcher gives up
+   when it sees that, or an inserted value with '<' or '>', and the passes
+   must be used.
+
+   The key and value pointers are borrowed from the string nodes, the
+   matcher must be rebuilt when the version of one of the subst_list
+   instances in the chain changes. The values are read when they are
+   inserted, a shared reference can be updated by the owner.
+*/
+class subst_matcher {
+public:
+    explicit subst_matcher(const subst_list_type *subst_list) {
+        std::vector<const subst_list_type *> lists;
+        for (auto list = subst_list; list != NULL; list = list->parent) {
+            chain.emplace_back(list, list->version);
+            lists.push_back(list);
+        }
+
+        for (auto list = lists.rbegin(); list != lists.rend(); ++list) {
+            for (int index = 0; index < vector_get_size((*list)->string_data);
+                 index++) {
+                const subst_list_string_type *node =
+                    (const subst_list_string_type *)vector_iget_const(
+                        (*list)->string_data, index);
+                if (node->value == NULL)
+                    continue;
+
+                std::string_view key = node->key;
+                if (!is_magic_string(key))
+                    compiled = false;
+                values.emplace(key, node->value);
+                for (size_t length = 1; length < key.size(); length++)
+                    prefixes.insert(key.substr(0, length));
+            }
+        }
+    }
+
+    bool is_current(const subst_list_type *subst_list) const {
+        auto link = chain.begin();
+        for (auto list = subst_list; list != NULL; list = list->parent) {
+            if (link == chain.end() || link->first != list ||
+                link->second != list->version)
+                return false;
+            ++link;
+        }
+        return link == chain.end();
+    }
+
+    /**
+       Replaces the keys in the \0 terminated string of the buffer, as
+       subst_list_replace_strings(), and sets match if something was
+       replaced. Returns false, with the buffer unchanged, if the passes
+       must be used instead.
+    */
+    bool replace(buffer_type *buffer, bool &match) const {
+        const char *data = (const char *)buffer_get_data(buffer);
+        const size_t size = buffer_get_size(buffer);
+        const char *end = (const char *)memchr(data, '\0', size);
+        if (!compiled || end == NULL)
+            return false;
+
+        std::string output;
+        if (!replace(std::string_view(data, end - data), output, match))
+            return false;
+
+        if (match) {
+            // The passes search with strstr(), and leave what follows the
+            // \0 as it is.
+            output.append(end, data + size - end);
+            buffer_clear(buffer);
+            buffer_fwrite(buffer, output.data(), 1, output.size());
+        }
+        return true;
+    }
+
+    /**
+       Calls f(open, close) for the ranges of text from a '<' to the
+       following '<' or '>', in the order they are searched by the matcher.
+       Stops, and returns false, when f() returns false.
+    */
+    template <typename Func>
+    static bool for_each_token(std::string_view text, Func f) {
+        size_t pos = 0;
+        while (true) {
+            size_t open = text.find('<', pos);
+            if (open == std::string_view::npos)
+                return true;
+
+            size_t close = text.find_first_of("<>", open + 1);
+            if (close == std::string_view::npos)
+                return true;
+
+            if (!f(open, close))
+                return false;
+            pos = text[close] == '<' ? close : close + 1;
+        }
+    }
+
+    /** Returned by find_value() when the passes must be used. */
+    static constexpr char invalid_value[] = "";
+
+    /**
+       The value which replaces the token from open to close in text; see
+       for_each_token(). Returns NULL if the token is not replaced, and
+       invalid_value if the passes must be used.
+    */
+    const char *find_value(std::string_view text, size_t open,
+                           size_t close) const {
+        if (text[close] == '<')
+            return prefixes.count(text.substr(open, close - open)) > 0
+                       ? invalid_value
+                       : NULL;
+
+        auto value = values.find(text.substr(open, close + 1 - open));
+        if (value == values.end())
+            return NULL;
+        if (strpbrk(value->second, "<>") != NULL)
+            return invalid_value;
+        return value->second;
+    }
+
+    bool is_compiled() const { return compiled; }
+
+private:
+    bool replace(std::string_view text, std::string &output,
+                 bool &match) const {
+        size_t copied = 0;
+        match = false;
+        output.reserve(text.size() + text.size() / 8);
+        bool replaced = for_each_token(text, [&](size_t open, size_t close) {
+            const char *value = find_value(text, open, close);
+            if (value == invalid_value)
+                return false;
+            if (value != NULL) {
+                output.append(text.substr(copied, open - copied));
+                output.append(value);
+                copied = close + 1;
+                match = true;
+            }
+            return true;
+        });
+        if (!replaced)
+            return false;
+        output.append(text.substr(copied));
+        return true;
+    }
+
+    std::vector<std::pair<const subst_list_type *, long>> chain;
+    bool compiled = true;
+    std::unordered_map<std::string_view, const char *> values;
+    std::unordered_set<std::string_view> prefixes;
+};
+
+} // namespace
+
+/**
+   Returns the compiled string substitutions of subst_list, which are
+   shared by the threads filtering with the same subst_list instance.
+*/
+static std::shared_ptr<const subst_matcher>
+subst_list_get_matcher(const subst_list_type *subst_list) {
+    std::lock_guard<std::mutex> lock(subst_list->matcher_mutex);
+    if (!subst_list->matcher || !subst_list->matcher->is_current(subst_list))
+        subst_list->matcher = std::make_shared<const subst_matcher>(subst_list);
+    return subst_list->matcher;
+}
+
 /**
   This function updates a buffer instance inplace with all the
   substitutions in the subst_list.
 
   This is the common low-level function employed by all the the
   subst_update_xxx() functions. Observe that it is a hard assumption
-  that the buffer has a \0 terminated string.
+  that the buffer has a \0 terminated string. The string substitutions
+  are done in one pass by the subst_matcher when that is possible.
 */
 bool subst_list_update_buffer(const subst_list_type *subst_list,
                               buffer_type *buffer) {
-    bool match1 = subst_list_replace_strings(subst_list, buffer);
+    bool match1;
+    if (!subst_list_get_matcher(subst_list)->replace(buffer, match1))
+        match1 = subst_list_replace_strings(subst_list, buffer);
     bool match2 = subst_list_eval_funcs__(subst_list, buffer);
     // Funny construction to ensure to avoid fault short circuit:
     return (match1 || match2);
@@ -682,6 +921,117 @@ bool subst_list_filter_file(const subst_list_type *subst_list,
     return match;
 }
 
+/**
+   The span at index, with up to length characters of the spans before and
+   after it on each side.
+*/
+static std::string span_context(const std::vector<std::string_view> &spans,
+                                size_t index, size_t length) {
+    std::string before;
+    for (size_t i = index; i > 0 && before.size() < length; i--) {
+        std::string_view span = spans[i - 1];
+        size_t count = std::min(span.size(), length - before.size());
+        before.insert(0, span.substr(span.size() - count));
+    }
+    std::string after;
+    for (size_t i = index + 1; i < spans.size() && after.size() < length; i++)
+        after.append(spans[i].substr(0, length - after.size()));
+    return before + std::string(spans[index]) + after;
+}
+
+ert::subst_file_filter::subst_file_filter(const char *src_file)
+    : src_file(src_file) {
+    std::error_code ec;
+    if (!fs::is_regular_file(src_file, ec))
+        return;
+
+    std::ifstream stream(src_file, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(stream),
+                   std::istreambuf_iterator<char>());
+    // The passes do not search past a \0, those files are left to
+    // subst_list_filter_file().
+    if (!stream || content.empty() ||
+        content.find('\0') != std::string::npos)
+        return;
+
+    loaded = true;
+    subst_matcher::for_each_token(content, [this](size_t open, size_t close) {
+        tokens.emplace_back(open, close);
+        return true;
+    });
+}
+
+bool ert::subst_file_filter::contains(const std::string &text) const {
+    std::lock_guard<std::mutex> lock(contains_mutex);
+    auto iter = contains_cache.find(text);
+    if (iter == contains_cache.end())
+        iter = contains_cache
+                   .emplace(text, content.find(text) != std::string::npos)
+                   .first;
+    return iter->second;
+}
+
+bool ert::subst_file_filter::filter(const subst_list_type *subst_list,
+                                    const char *target_file,
+                                    runpath_manifest *manifest) const {
+    auto filter_file = [&]() {
+        if (manifest != NULL)
+            manifest->erase(target_file);
+        return subst_list_filter_file(subst_list, src_file.c_str(),
+                                      target_file);
+    };
+    if (!loaded || util_same_file(src_file.c_str(), target_file))
+        return filter_file();
+
+    auto matcher = subst_list_get_matcher(subst_list);
+    if (!matcher->is_compiled())
+        return filter_file();
+
+    // The unchanged spans of the source, with the substituted values at
+    // the odd indices.
+    const std::string_view text(content);
+    std::vector<std::string_view> spans;
+    size_t copied = 0;
+    for (const auto &[open, close] : tokens) {
+        const char *value = matcher->find_value(text, open, close);
+        if (value == subst_matcher::invalid_value)
+            return filter_file();
+        if (value != NULL) {
+            spans.push_back(text.substr(copied, open - copied));
+            spans.push_back(value);
+            copied = close + 1;
+        }
+    }
+    spans.push_back(text.substr(copied));
+
+    // The functions are evaluated by subst_list_filter_file(), when the
+    // name of one can be in the filtered text. That is in the source, or
+    // around a substituted value.
+    for (auto list = subst_list; list != NULL; list = list->parent) {
+        for (int index = 0; index < vector_get_size(list->func_data);
+             index++) {
+            const subst_list_func_type *subst_func =
+                (const subst_list_func_type *)vector_iget_const(
+                    list->func_data, index);
+            const std::string name = subst_func->name;
+            if (contains(name))
+                return filter_file();
+
+            for (size_t value = 1; value < spans.size(); value += 2) {
+                if (span_context(spans, value, name.size() - 1).find(name) !=
+                    std::string::npos)
+                    return filter_file();
+            }
+        }
+    }
+
+    bool written = manifest != NULL ? manifest->write_file(target_file, spans)
+                                    : write_file_spans(target_file, spans);
+    if (!written)
+        return filter_file();
+    return spans.size() > 1;
+}
+
 /**
    This function does search-replace on string instance inplace.
 */
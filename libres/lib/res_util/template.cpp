@@ -16,14 +16,23 @@
    for more details.
 */
 
+#include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <ert/util/ert_api_config.hpp>
 
 #include <ert/res_util/file_utils.hpp>
+#include <ert/res_util/runpath_manifest.hpp>
 #include <ert/util/stringlist.hpp>
 #include <ert/util/util.hpp>
 
@@ -33,37 +42,182 @@
 
 namespace fs = std::filesystem;
 
+/**
+   The content of a template after the substitutions of the template
+   arguments; it is the same for all the instantiations as long as the
+   template file and the arguments are unchanged.
+
+   When the run arguments do not substitute anything in the text, the
+   instance is the same for all the realizations. The first such instance
+   is recorded as the shared file, and the following instances are cloned
+   from it - see template_clone_shared(). If the file system can not clone
+   the shared file, the instances are written instead.
+*/
+struct template_content_struct {
+    std::string template_file;
+    long args_version;
+    fs::file_time_type mtime;
+    std::uintmax_t size;
+    std::string text;
+
+    mutable std::mutex shared_mutex;
+    mutable std::string shared_file;
+    mutable fs::file_time_type shared_mtime;
+    mutable std::uintmax_t shared_size = 0;
+    mutable bool clone_failed = false;
+};
+
 /**
    Iff the template is set up with internaliz_template == false the
    template content is loaded at instantiation time, and in that case
    the name of the template file can contain substitution characters -
    i.e. in this case different instance can use different source
    templates.
-
-   To avoid race issues this function does not set actually update the
-   state of the template object.
 */
-static char *template_load(const template_type *_template,
-                           const subst_list_type *ext_arg_list) {
-    int buffer_size;
+static char *template_alloc_file(const template_type *_template,
+                                 const subst_list_type *ext_arg_list) {
     char *template_file = util_alloc_string_copy(_template->template_file);
-    char *template_buffer;
 
     subst_list_update_string(_template->arg_list, &template_file);
     if (ext_arg_list != NULL)
         subst_list_update_string(ext_arg_list, &template_file);
 
-    template_buffer =
+    return template_file;
+}
+
+/**
+   To avoid race issues this function does not set actually update the
+   state of the template object.
+*/
+static char *template_load(const template_type *_template,
+                           const subst_list_type *ext_arg_list) {
+    int buffer_size;
+    char *template_file = template_alloc_file(_template, ext_arg_list);
+    char *template_buffer =
         util_fread_alloc_file_content(template_file, &buffer_size);
     free(template_file);
 
     return template_buffer;
 }
 
+/**
+   Returns the template content after the substitutions of the template
+   arguments. The content is kept in the template, and is reused by the
+   instantiations, also from other threads, until the arguments or the
+   modification time and size of the template file change.
+
+   Only one content is kept. When the name of the template file depends on
+   the run arguments, e.g. template-<IENS>, every realization has its own
+   template and the content is not kept at all.
+*/
+static std::shared_ptr<const template_content_struct>
+template_get_content(const template_type *template_,
+                     const subst_list_type *ext_arg_list) {
+    auto content = std::make_shared<template_content_struct>();
+    content->args_version = subst_list_get_version(template_->arg_list);
+    content->size = 0;
+
+    const std::string &template_file = content->template_file;
+    bool cache = true;
+    if (!template_->internalize_template) {
+        char *file = util_alloc_string_copy(template_->template_file);
+        subst_list_update_string(template_->arg_list, &file);
+        if (ext_arg_list != NULL)
+            cache = !subst_list_update_string(ext_arg_list, &file);
+        content->template_file = file;
+        free(file);
+
+        std::error_code ec;
+        content->mtime = fs::last_write_time(template_file, ec);
+        if (!ec)
+            content->size = fs::file_size(template_file, ec);
+        cache = cache && !ec;
+    }
+
+    if (cache) {
+        std::lock_guard<std::mutex> lock(template_->content_mutex);
+        auto cached = template_->content_cache;
+        if (cached && cached->template_file == template_file &&
+            cached->args_version == content->args_version &&
+            cached->mtime == content->mtime && cached->size == content->size)
+            return cached;
+    }
+
+    char *char_buffer;
+    if (template_->internalize_template)
+        char_buffer = util_alloc_string_copy(template_->template_buffer);
+    else {
+        int buffer_size;
+        char_buffer =
+            util_fread_alloc_file_content(template_file.c_str(), &buffer_size);
+    }
+    subst_list_update_string(template_->arg_list, &char_buffer);
+    content->text = char_buffer;
+    free(char_buffer);
+
+    if (cache) {
+        std::lock_guard<std::mutex> lock(template_->content_mutex);
+        template_->content_cache = content;
+    }
+    return content;
+}
+
+/**
+   Creates target_file as a clone of the shared file of the content, if
+   there is one and it has not been modified since it was written; returns
+   false otherwise. The instances are cloned, and not hard linked, since
+   the forward model can update its files in place.
+
+   The shared file is taken to be unmodified when its modification time and
+   size are; a modification which keeps both is not noticed.
+*/
+static bool template_clone_shared(const template_content_struct &content,
+                                  const char *target_file) {
+    std::string shared_file;
+    {
+        std::lock_guard<std::mutex> lock(content.shared_mutex);
+        shared_file = content.shared_file;
+        if (content.clone_failed || shared_file.empty() ||
+            shared_file == target_file)
+            return false;
+
+        std::error_code ec;
+        auto mtime = fs::last_write_time(shared_file, ec);
+        if (ec || mtime != content.shared_mtime ||
+            fs::file_size(shared_file, ec) != content.shared_size || ec) {
+            content.shared_file.clear();
+            return false;
+        }
+    }
+    if (clone_file(shared_file, target_file))
+        return true;
+
+    std::lock_guard<std::mutex> lock(content.shared_mutex);
+    content.clone_failed = true;
+    return false;
+}
+
+static void template_set_shared(const template_content_struct &content,
+                                const char *target_file) {
+    std::error_code ec;
+    auto mtime = fs::last_write_time(target_file, ec);
+    auto size = fs::file_size(target_file, ec);
+    if (ec)
+        return;
+
+    std::lock_guard<std::mutex> lock(content.shared_mutex);
+    if (content.clone_failed)
+        return;
+    content.shared_file = target_file;
+    content.shared_mtime = mtime;
+    content.shared_size = size;
+}
+
 void template_set_template_file(template_type *_template,
                                 const char *template_file) {
     _template->template_file =
         util_realloc_string_copy(_template->template_file, template_file);
+    _template->content_cache.reset();
     if (_template->internalize_template) {
         free(_template->template_buffer);
         _template->template_buffer = template_load(_template, NULL);
@@ -85,7 +239,7 @@ const char *template_get_template_file(const template_type *_template) {
 template_type *template_alloc(const char *template_file,
                               bool internalize_template,
                               subst_list_type *parent_subst) {
-    template_type *_template = (template_type *)util_malloc(sizeof *_template);
+    template_type *_template = new template_type();
     UTIL_TYPE_ID_INIT(_template, TEMPLATE_TYPE_ID);
     _template->arg_list = subst_list_alloc(parent_subst);
     _template->template_buffer = NULL;
@@ -111,7 +265,7 @@ void template_free(template_type *_template) {
     regfree(&_template->end_regexp);
 #endif
 
-    free(_template);
+    delete _template;
 }
 
 /**
@@ -137,11 +291,15 @@ void template_free(template_type *_template) {
          symbolic link will be removed prior to creating the instance,
          ensuring that a remote file is not updated.
 
+    5. If @manifest is not NULL the target file is only written when
+       its content changes, see ert::runpath_manifest.
+
 */
 void template_instantiate(const template_type *template_,
                           const char *__target_file,
                           const subst_list_type *arg_list,
-                          bool override_symlink) {
+                          bool override_symlink,
+                          ert::runpath_manifest *manifest) {
     char *target_file = util_alloc_string_copy(__target_file);
 
     /* Finding the name of the target file. */
@@ -150,20 +308,32 @@ void template_instantiate(const template_type *template_,
         subst_list_update_string(arg_list, &target_file);
 
     {
-        char *char_buffer;
         /* Loading the template - possibly expanding keys in the filename */
-        if (template_->internalize_template)
-            char_buffer = util_alloc_string_copy(template_->template_buffer);
-        else
-            char_buffer = template_load(template_, arg_list);
+        auto content = template_get_content(template_, arg_list);
+        char *char_buffer = util_alloc_string_copy(content->text.c_str());
 
         /* Substitutions on the content. */
-        subst_list_update_string(template_->arg_list, &char_buffer);
+        bool substituted = false;
         if (arg_list != NULL)
-            subst_list_update_string(arg_list, &char_buffer);
+            substituted = subst_list_update_string(arg_list, &char_buffer);
+
+        // Check if target file already exists as a symlink,
+        // and remove it if override_symlink is true.
+        if (override_symlink) {
+            if (util_is_link(target_file))
+                remove(target_file);
+        }
+
+        if (!substituted && manifest == NULL &&
+            template_clone_shared(*content, target_file)) {
+            free(char_buffer);
+            free(target_file);
+            return;
+        }
 
 #ifdef ERT_HAVE_REGEXP
-        {
+        // The loops start with "{%", which most templates do not have.
+        if (strstr(char_buffer, "{%") != NULL) {
             buffer_type *buffer = buffer_alloc_private_wrapper(
                 char_buffer, strlen(char_buffer) + 1);
             template_eval_loops(template_, buffer);
@@ -172,19 +342,24 @@ void template_instantiate(const template_type *template_,
         }
 #endif
 
-        // Check if target file already exists as a symlink,
-        // and remove it if override_symlink is true.
-        if (override_symlink) {
-            if (util_is_link(target_file))
-                remove(target_file);
-        }
-
         /* Write the content out. */
-        {
+        bool cloned = false;
+        if (manifest != NULL) {
+            // A changed file is still cloned, and then recorded.
+            std::vector<std::string_view> spans{char_buffer};
+            if (!substituted && !manifest->unchanged(target_file, spans) &&
+                template_clone_shared(*content, target_file)) {
+                manifest->add_file(target_file, spans);
+                cloned = true;
+            } else if (!manifest->write_file(target_file, spans))
+                util_abort("%s: failed to write:%s \n", __func__, target_file);
+        } else {
             auto stream = mkdir_fopen(fs::path(target_file), "w");
             fprintf(stream, "%s", char_buffer);
             fclose(stream);
         }
+        if (!substituted && !cloned)
+            template_set_shared(*content, target_file);
         free(char_buffer);
     }
 
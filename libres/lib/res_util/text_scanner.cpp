@@ -0,0 +1,137 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'text_scanner.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+#include <ert/util/util.h>
+
+#include <ert/res_util/text_scanner.hpp>
+
+namespace {
+bool is_space(char c) { return std::isspace(static_cast<unsigned char>(c)); }
+bool is_digit(char c) { return std::isdigit(static_cast<unsigned char>(c)); }
+} // namespace
+
+namespace ert {
+
+text_scanner::text_scanner(const char *filename) {
+    FILE *stream = util_fopen(filename, "r");
+    char chunk[1 << 16];
+    size_t bytes;
+    while ((bytes = fread(chunk, 1, sizeof chunk, stream)) > 0)
+        content.append(chunk, bytes);
+    fclose(stream);
+}
+
+text_scanner text_scanner::from_string(std::string content) {
+    text_scanner scanner;
+    scanner.content = std::move(content);
+    return scanner;
+}
+
+void text_scanner::skip_space() {
+    while (pos < content.size() && is_space(content[pos]))
+        pos++;
+}
+
+bool text_scanner::at_end() {
+    skip_space();
+    return pos == content.size();
+}
+
+bool text_scanner::scan(int &value) {
+    skip_space();
+    const char *begin = content.data() + pos;
+    const char *end = content.data() + content.size();
+
+    // from_chars() does not take the plus sign which "%d" allows.
+    const char *digits = begin;
+    if (digits < end && *digits == '+' && digits + 1 < end &&
+        is_digit(digits[1]))
+        digits++;
+
+    auto result = std::from_chars(digits, end, value);
+    if (result.ec != std::errc())
+        return false;
+
+    pos += result.ptr - begin;
+    return true;
+}
+
+/*
+  The floating point values are converted with strtof()/strtod(), which are
+  what "%g" and "%lg" use, and accept the same input; the content is NUL
+  terminated, so they stop at the end of it.
+*/
+bool text_scanner::scan(float &value) {
+    skip_space();
+    const char *begin = content.c_str() + pos;
+    char *end;
+    float result = std::strtof(begin, &end);
+    if (end == begin)
+        return false;
+
+    value = result;
+    pos += end - begin;
+    return true;
+}
+
+bool text_scanner::scan(double &value) {
+    skip_space();
+    const char *begin = content.c_str() + pos;
+    char *end;
+    double result = std::strtod(begin, &end);
+    if (end == begin)
+        return false;
+
+    value = result;
+    pos += end - begin;
+    return true;
+}
+
+bool text_scanner::scan(std::string &word) {
+    skip_space();
+    size_t end = pos;
+    while (end < content.size() && !is_space(content[end]))
+        end++;
+    if (end == pos)
+        return false;
+
+    word.assign(content, pos, end - pos);
+    pos = end;
+    return true;
+}
+
+int text_scanner::line() const {
+    return 1 + std::count(content.begin(), content.begin() + pos, '\n');
+}
+
+int text_scanner::column() const {
+    if (pos == 0)
+        return 1;
+
+    size_t newline = content.rfind('\n', pos - 1);
+    return newline == std::string::npos ? 1 + pos : pos - newline;
+}
+
+} // namespace ert
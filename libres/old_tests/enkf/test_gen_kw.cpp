@@ -28,13 +28,14 @@
 #include <ert/util/vector.hpp>
 
 #include <ert/enkf/gen_kw_config.hpp>
+#include <ert/res_util/runpath_manifest.hpp>
 
 namespace fs = std::filesystem;
 
 namespace enkf_main {
 void ecl_write(const ensemble_config_type *ens_config,
                const char *export_base_name, const run_arg_type *run_arg,
-               enkf_fs_type *fs);
+               enkf_fs_type *fs, ert::runpath_manifest *manifest = NULL);
 } // namespace enkf_main
 
 void test_write_gen_kw_export_file(enkf_main_type *enkf_main) {
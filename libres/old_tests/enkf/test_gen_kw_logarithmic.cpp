@@ -24,13 +24,14 @@
 #include <ert/util/test_util.h>
 
 #include <ert/enkf/gen_kw.hpp>
+#include <ert/res_util/runpath_manifest.hpp>
 
 namespace fs = std::filesystem;
 
 namespace enkf_main {
 void ecl_write(const ensemble_config_type *ens_config,
                const char *export_base_name, const run_arg_type *run_arg,
-               enkf_fs_type *fs);
+               enkf_fs_type *fs, ert::runpath_manifest *manifest = NULL);
 
 } // namespace enkf_main
 
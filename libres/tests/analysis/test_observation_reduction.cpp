@@ -0,0 +1,162 @@
+#include <cmath>
+#include <optional>
+#include <vector>
+
+#include <Eigen/Dense>
+#include <catch2/catch.hpp>
+
+#include <ert/analysis/update.hpp>
+
+namespace analysis {
+ReducedObservations
+reduce_block_average(const Eigen::Ref<const Eigen::MatrixXd> &S,
+                     const Eigen::Ref<const Eigen::VectorXd> &values,
+                     const Eigen::Ref<const Eigen::VectorXd> &errors,
+                     int block_size);
+std::optional<ReducedObservations>
+reduce_principal_components(const Eigen::Ref<const Eigen::MatrixXd> &S,
+                            const Eigen::Ref<const Eigen::VectorXd> &values,
+                            const Eigen::Ref<const Eigen::VectorXd> &errors,
+                            double variance_fraction);
+void reduce_observations(const ObservationReduction &reduction,
+                         const std::vector<ObservationGroup> &groups,
+                         Eigen::MatrixXd &S, Eigen::VectorXd &values,
+                         Eigen::VectorXd &errors);
+} // namespace analysis
+
+using namespace analysis;
+
+TEST_CASE("Block averages of observations", "[analysis]") {
+    Eigen::MatrixXd S(5, 2);
+    S << 1, 2, 3, 4, 5, 6, 7, 8, 9, 10;
+    Eigen::VectorXd values(5);
+    values << 1, 3, 5, 7, 9;
+    Eigen::VectorXd errors(5);
+    errors << 3, 4, 1, 1, 2;
+
+    auto reduced = reduce_block_average(S, values, errors, 2);
+
+    // The last block only has one element.
+    Eigen::MatrixXd expected_S(3, 2);
+    expected_S << 2, 3, 6, 7, 9, 10;
+    Eigen::VectorXd expected_values(3);
+    expected_values << 2, 6, 9;
+    Eigen::VectorXd expected_errors(3);
+    expected_errors << 2.5, std::sqrt(2.0) / 2, 2;
+
+    REQUIRE(reduced.S.isApprox(expected_S));
+    REQUIRE(reduced.values.isApprox(expected_values));
+    REQUIRE(reduced.errors.isApprox(expected_errors));
+}
+
+TEST_CASE("Principal components of observations", "[analysis]") {
+    // Six observations of an ensemble of four, where the error normalised
+    // responses only vary in two directions.
+    Eigen::VectorXd errors(6);
+    errors << 1, 2, 0.5, 1, 4, 2;
+    Eigen::MatrixXd coefficients(2, 4);
+    coefficients << 1, -1, 2, -2, 0.5, 0.5, -0.5, -0.5;
+    Eigen::MatrixXd directions(6, 2);
+    directions << 1, 0, 2, 1, 0, 1, -1, 3, 1, 1, 0, -2;
+    Eigen::VectorXd mean(6);
+    mean << 10, 20, 30, 40, 50, 60;
+    Eigen::MatrixXd S = errors.asDiagonal() *
+                        ((directions * coefficients).colwise() + mean);
+    Eigen::VectorXd values(6);
+    values << 11, 19, 32, 41, 48, 61;
+
+    GIVEN("Retaining all the variance") {
+        auto reduced = reduce_principal_components(S, values, errors, 1.0);
+        REQUIRE(reduced);
+        REQUIRE(reduced->values.size() == 2);
+        REQUIRE(reduced->errors == Eigen::VectorXd::Ones(2));
+
+        THEN("The transformed error covariance is the identity") {
+            // The transformation of the values is linear, the columns of T
+            // are the transformed unit vectors.
+            Eigen::MatrixXd T(2, 6);
+            for (int i = 0; i < 6; i++) {
+                auto unit = reduce_principal_components(
+                    S, Eigen::VectorXd::Unit(6, i), errors, 1.0);
+                T.col(i) = unit->values;
+            }
+            Eigen::MatrixXd R = errors.cwiseAbs2().asDiagonal();
+            REQUIRE((T * R * T.transpose())
+                        .isApprox(Eigen::MatrixXd::Identity(2, 2)));
+            REQUIRE(reduced->S.isApprox(T * S));
+            REQUIRE(reduced->values.isApprox(T * values));
+        }
+
+        THEN("The components are uncorrelated and keep the spread") {
+            Eigen::MatrixXd anomalies =
+                reduced->S.colwise() - reduced->S.rowwise().mean();
+            Eigen::MatrixXd covariance = anomalies * anomalies.transpose();
+            REQUIRE(std::abs(covariance(0, 1)) < 1e-9 * covariance(0, 0));
+            REQUIRE(covariance(0, 0) >= covariance(1, 1));
+
+            Eigen::MatrixXd Sw = errors.cwiseInverse().asDiagonal() * S;
+            Eigen::MatrixXd original = Sw.colwise() - Sw.rowwise().mean();
+            REQUIRE((anomalies.transpose() * anomalies)
+                        .isApprox(original.transpose() * original));
+        }
+    }
+
+    GIVEN("Retaining part of the variance") {
+        auto reduced = reduce_principal_components(S, values, errors, 0.5);
+        REQUIRE(reduced);
+        REQUIRE(reduced->values.size() == 1);
+    }
+
+    GIVEN("An ensemble without spread") {
+        Eigen::MatrixXd flat = mean.replicate(1, 4);
+        REQUIRE_FALSE(reduce_principal_components(flat, values, errors, 1.0));
+    }
+
+    GIVEN("As many components as observations") {
+        REQUIRE_FALSE(reduce_principal_components(S.topRows(2), values.head(2),
+                                                  errors.head(2), 1.0));
+    }
+}
+
+TEST_CASE("Reduction of observation groups", "[analysis]") {
+    // Group A is smaller than the groups which are reduced below.
+    std::vector<ObservationGroup> groups{{"A", 0, 2}, {"B", 2, 4}};
+    Eigen::MatrixXd S(6, 2);
+    S << 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12;
+    Eigen::VectorXd values(6);
+    values << 1, 2, 3, 4, 5, 6;
+    Eigen::VectorXd errors(6);
+    errors << 0.1, 0.2, 1, 1, 1, 1;
+
+    GIVEN("Block averages") {
+        ObservationReduction reduction;
+        reduction.min_size = 3;
+        reduction.block_size = 2;
+        reduce_observations(reduction, groups, S, values, errors);
+
+        Eigen::MatrixXd expected_S(4, 2);
+        expected_S << 1, 2, 3, 4, 6, 7, 10, 11;
+        Eigen::VectorXd expected_values(4);
+        expected_values << 1, 2, 3.5, 5.5;
+        Eigen::VectorXd expected_errors(4);
+        expected_errors << 0.1, 0.2, std::sqrt(0.5), std::sqrt(0.5);
+        REQUIRE(S.isApprox(expected_S));
+        REQUIRE(values.isApprox(expected_values));
+        REQUIRE(errors.isApprox(expected_errors));
+    }
+
+    GIVEN("Principal components of groups without spread") {
+        ObservationReduction reduction;
+        reduction.min_size = 2;
+        reduction.block_size = 0;
+        S.col(1) = S.col(0);
+        Eigen::MatrixXd original_S = S;
+        Eigen::VectorXd original_values = values;
+        Eigen::VectorXd original_errors = errors;
+        reduce_observations(reduction, groups, S, values, errors);
+
+        REQUIRE(S == original_S);
+        REQUIRE(values == original_values);
+        REQUIRE(errors == original_errors);
+    }
+}
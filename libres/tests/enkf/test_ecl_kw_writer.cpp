@@ -0,0 +1,86 @@
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tmpdir.hpp"
+#include "catch2/catch.hpp"
+#include <ert/ecl/ecl_endian_flip.h>
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/fortio.h>
+#include <ert/enkf/ecl_kw_writer.hpp>
+
+namespace {
+std::string read_file(const std::filesystem::path &filename) {
+    std::ifstream stream(filename, std::ios::binary);
+    std::stringstream content;
+    content << stream.rdbuf();
+    return content.str();
+}
+
+template <typename T> std::vector<T> random_values(int size) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> mantissa(-1, 1);
+    std::uniform_int_distribution<int> exponent(-30, 30);
+    std::vector<T> values;
+    for (int i = 0; i < size; i++)
+        values.push_back(mantissa(rng) * std::pow(10.0, exponent(rng)));
+    for (double value : {0.0, 1.0, -1.0, 10.0, 0.5, 1e-20, 1234.5})
+        values.push_back(value);
+    return values;
+}
+
+void require_same_output(ecl_data_type data_type, int size, void *data) {
+    ecl_kw_type *ecl_kw =
+        ecl_kw_alloc_new_shared("PORO", size, data_type, data);
+
+    FILE *stream = fopen("expected.grdecl", "w");
+    ecl_kw_fprintf_grdecl(ecl_kw, stream);
+    fclose(stream);
+    stream = fopen("actual.grdecl", "w");
+    ert::fwrite_grdecl(stream, "PORO", data_type, size, data);
+    fclose(stream);
+    REQUIRE(read_file("actual.grdecl") == read_file("expected.grdecl"));
+
+    fortio_type *fortio =
+        fortio_open_writer("expected.kw", false, ECL_ENDIAN_FLIP);
+    ecl_kw_fwrite_param_fortio(fortio, "PORO", data_type, size, data);
+    fortio_fclose(fortio);
+    stream = fopen("actual.kw", "w");
+    ert::fwrite_ecl_kw(stream, "PORO", data_type, size, data);
+    fclose(stream);
+    REQUIRE(read_file("actual.kw") == read_file("expected.kw"));
+
+    ecl_kw_free(ecl_kw);
+}
+} // namespace
+
+TEST_CASE("ecl_kw_writer writes the same files as ecl_kw", "[enkf]") {
+    WITH_TMPDIR;
+    const int size = 2503;
+
+    SECTION("float") {
+        auto values = random_values<float>(size);
+        require_same_output(ECL_FLOAT, values.size(), values.data());
+    }
+
+    SECTION("double") {
+        auto values = random_values<double>(size);
+        require_same_output(ECL_DOUBLE, values.size(), values.data());
+    }
+
+    SECTION("int") {
+        std::vector<int> values;
+        for (int i = 0; i < size; i++)
+            values.push_back((i - size / 2) * 997);
+        require_same_output(ECL_INT, values.size(), values.data());
+    }
+
+    SECTION("empty") {
+        float value = 0;
+        require_same_output(ECL_FLOAT, 0, &value);
+    }
+}
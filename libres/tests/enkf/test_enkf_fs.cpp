@@ -3,8 +3,11 @@
 
 #include "catch2/catch.hpp"
 
+#include <ert/enkf/block_fs_driver.hpp>
 #include <ert/enkf/enkf_fs.hpp>
 #include <ert/enkf/enkf_obs.hpp>
+#include <ert/enkf/summary.hpp>
+#include <ert/enkf/summary_table.hpp>
 
 #include "../tmpdir.hpp"
 #include "ert/res_util/block_fs.hpp"
@@ -44,6 +47,18 @@ TEST_CASE("enkf_fs_fwrite_misfit", "[enkf_fs]") {
                 REQUIRE(std::filesystem::exists(file_path / "files" /
                                                 "misfit-ensemble"));
             }
+
+            THEN("Unchanged misfits are not written again") {
+                auto misfit_file = file_path / "files" / "misfit-ensemble";
+                enkf_fs_fwrite_misfit(fs);
+                std::filesystem::remove(misfit_file);
+
+                misfit_ensemble_initialize(misfit_ensemble, ensemble_config,
+                                           enkf_obs, fs, ens_size,
+                                           history_length, true);
+                enkf_fs_fwrite_misfit(fs);
+                REQUIRE(!std::filesystem::exists(misfit_file));
+            }
         }
         // Hack:
         // Want to call enkf_fs_umout to do cleanup.
@@ -79,6 +94,44 @@ TEST_CASE("block_fs", "[enkf_fs]") {
                 REQUIRE(!block_fs_has_file(bfs, "BAR"));
             }
 
+            THEN("existence can be checked in bulk") {
+                auto has_files =
+                    block_fs_has_files(bfs, {"BAR", "FOO", "FOO.0"});
+                REQUIRE(has_files == std::vector<bool>{false, true, false});
+            }
+
+            THEN("several files can be read in bulk") {
+                block_fs_fwrite_file(bfs, "BAR", random.data() + 10, 20);
+                block_fs_fwrite_file(bfs, "EMPTY", random.data(), 0);
+                std::vector<buffer_type *> buffers;
+                for (int i = 0; i < 4; i++)
+                    buffers.push_back(buffer_alloc(100));
+
+                auto has_files = block_fs_fread_files(
+                    bfs, {"BAR", "MISSING", "FOO", "EMPTY"}, buffers);
+                REQUIRE(has_files ==
+                        std::vector<bool>{true, false, true, true});
+                REQUIRE(buffer_get_size(buffers[0]) == 20);
+                REQUIRE(std::memcmp(random.data() + 10,
+                                    buffer_get_data(buffers[0]), 20) == 0);
+                REQUIRE(buffer_get_size(buffers[1]) == 0);
+                REQUIRE(buffer_get_size(buffers[2]) == random.size());
+                REQUIRE(std::memcmp(random.data(),
+                                    buffer_get_data(buffers[2]),
+                                    random.size()) == 0);
+                REQUIRE(buffer_get_size(buffers[3]) == 0);
+                for (auto buffer : buffers)
+                    buffer_free(buffer);
+            }
+
+            THEN("a range of the data can be read") {
+                std::vector<char> part(100);
+                block_fs_fread_range(bfs, "FOO", 250, part.data(),
+                                     part.size());
+                REQUIRE(std::memcmp(random.data() + 250, part.data(),
+                                    part.size()) == 0);
+            }
+
             AND_THEN("data can be read from the same instance") {
                 auto buf = buffer_alloc(100);
                 block_fs_fread_realloc_buffer(bfs, "FOO", buf);
@@ -154,3 +207,131 @@ TEST_CASE("block_fs", "[enkf_fs]") {
         block_fs_close(bfs);
     }
 }
+
+TEST_CASE("block_fs_driver with several block_fs instances", "[enkf_fs]") {
+    WITH_TMPDIR;
+    const int num_fs = 3;
+    {
+        FILE *stream = fopen("ert_fstab", "w");
+        block_fs_driver_create_fs(stream, ".", DRIVER_PARAMETER, num_fs,
+                                  "Ensemble/mod_%d", "PARAMETER");
+        fclose(stream);
+    }
+    FILE *stream = fopen("ert_fstab", "r");
+    fs_driver_enum driver_type;
+    REQUIRE(fread(&driver_type, sizeof driver_type, 1, stream) == 1);
+    auto driver = ert::block_fs_driver::open(stream, ".", false);
+    fclose(stream);
+
+    // The realizations are spread over the instances with iens % num_fs,
+    // and are listed out of order below.
+    auto buffer = buffer_alloc(100);
+    for (int iens : {0, 1, 2, 4, 5, 7}) {
+        buffer_clear(buffer);
+        buffer_fwrite_int(buffer, 100 + iens);
+        driver->save_node("PORO", 0, iens, buffer);
+        driver->save_vector("FOPR", iens, buffer);
+    }
+    buffer_free(buffer);
+
+    const std::vector<int> iens_list{7, 3, 0, 5, 6, 2, 4, 1, 8};
+    const std::vector<bool> expected{true, false, true,  true, false,
+                                     true, true,  true, false};
+    std::vector<node_id_type> node_ids;
+    for (int iens : iens_list)
+        node_ids.push_back({.report_step = 0, .iens = iens});
+
+    THEN("the existence is checked in the order of the realizations") {
+        REQUIRE(driver->has_nodes("PORO", node_ids) == expected);
+        REQUIRE(driver->has_vectors("FOPR", iens_list) == expected);
+        for (size_t i = 0; i < iens_list.size(); i++)
+            REQUIRE(driver->has_node("PORO", 0, iens_list[i]) == expected[i]);
+    }
+
+    THEN("the nodes are read into the buffers of the realizations") {
+        std::vector<std::string> node_keys(node_ids.size(), "PORO");
+        std::vector<buffer_type *> buffers;
+        for (size_t i = 0; i < node_ids.size(); i++)
+            buffers.push_back(buffer_alloc(100));
+
+        REQUIRE(driver->load_nodes(node_keys, node_ids, buffers) == expected);
+        for (size_t i = 0; i < node_ids.size(); i++) {
+            if (expected[i]) {
+                buffer_rewind(buffers[i]);
+                REQUIRE(buffer_fread_int(buffers[i]) == 100 + iens_list[i]);
+            } else
+                REQUIRE(buffer_get_size(buffers[i]) == 0);
+            buffer_free(buffers[i]);
+        }
+    }
+
+    delete driver;
+}
+
+TEST_CASE("summary_record", "[enkf_fs]") {
+    const float undefined = summary_undefined_value();
+    ert::summary_columns columns;
+    ert::summary_record record;
+
+    int fopr = columns.add("FOPR");
+    record.resize(columns.size(), 3);
+    record.column(fopr)[1] = 1.5;
+
+    int fopt = columns.add("FOPT");
+    record.resize(columns.size(), 4);
+    record.column(fopt)[3] = 3.5;
+    REQUIRE(columns.add("FOPR") == fopr);
+    REQUIRE(columns.get("WOPR:OP1") == -1);
+
+    auto buffer = buffer_alloc(100);
+    record.fwrite(buffer);
+    const char *data = static_cast<const char *>(buffer_get_data(buffer));
+    auto read_range = [data](size_t offset, void *ptr, size_t byte_size) {
+        std::memcpy(ptr, data + offset, byte_size);
+    };
+
+    THEN("a single column can be read from the stored record") {
+        std::vector<float> values;
+        REQUIRE(ert::summary_record::fread_column(read_range, fopr, &values));
+        REQUIRE(values == std::vector<float>{undefined, 1.5, undefined,
+                                             undefined});
+        REQUIRE(ert::summary_record::fread_column(read_range, fopt, &values));
+        REQUIRE(values == std::vector<float>{undefined, undefined, undefined,
+                                             3.5});
+    }
+
+    THEN("columns which are not stored are reported missing") {
+        REQUIRE(!ert::summary_record::fread_column(read_range, 2, nullptr));
+
+        ert::summary_record other;
+        other.resize(2, 1);
+        other.column(fopt)[0] = 0;
+        auto other_buffer = buffer_alloc(100);
+        other.fwrite(other_buffer);
+        const char *other_data =
+            static_cast<const char *>(buffer_get_data(other_buffer));
+        auto other_range = [other_data](size_t offset, void *ptr,
+                                        size_t byte_size) {
+            std::memcpy(ptr, other_data + offset, byte_size);
+        };
+        REQUIRE(!ert::summary_record::fread_column(other_range, fopr, nullptr));
+        REQUIRE(ert::summary_record::fread_column(other_range, fopt, nullptr));
+        buffer_free(other_buffer);
+    }
+
+    THEN("the record can be read back and extended") {
+        ert::summary_record loaded;
+        buffer_rewind(buffer);
+        loaded.fread(buffer);
+        REQUIRE(loaded.num_columns() == 2);
+        REQUIRE(loaded.num_steps() == 4);
+
+        loaded.resize(3, 5);
+        REQUIRE(loaded.has_column(fopr));
+        REQUIRE(!loaded.has_column(2));
+        REQUIRE(loaded.column(fopr)[1] == 1.5);
+        REQUIRE(loaded.column(fopt)[3] == 3.5);
+        REQUIRE(loaded.column(fopt)[4] == undefined);
+    }
+    buffer_free(buffer);
+}
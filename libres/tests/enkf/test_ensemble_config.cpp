@@ -0,0 +1,42 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/ensemble_config.hpp>
+
+TEST_CASE("Summary nodes are created once when loading concurrently",
+          "[enkf]") {
+    auto ensemble_config = ensemble_config_alloc_full("<%s>");
+
+    // Each thread sees the keys of a realization, which partly overlap
+    const int num_threads = 8;
+    const int num_keys = 200;
+    std::vector<std::vector<enkf_config_node_type *>> nodes(num_threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++)
+        threads.emplace_back([&, t] {
+            std::vector<std::string> keys;
+            for (int i = 0; i < num_keys; i++)
+                keys.push_back("WOPR:OP_" + std::to_string(i + t * 10));
+            nodes[t] = ensemble_config_get_or_create_summary_nodes(
+                ensemble_config, keys);
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    REQUIRE(ensemble_config_get_size(ensemble_config) ==
+            num_keys + (num_threads - 1) * 10);
+    for (int t = 0; t < num_threads; t++)
+        for (int i = 0; i < num_keys; i++) {
+            auto key = "WOPR:OP_" + std::to_string(i + t * 10);
+            REQUIRE(nodes[t][i] ==
+                    ensemble_config_get_node(ensemble_config, key.c_str()));
+            REQUIRE(enkf_config_node_get_impl_type(nodes[t][i]) == SUMMARY);
+        }
+
+    REQUIRE(ensemble_config_get_or_create_summary_node(
+                ensemble_config, "WOPR:OP_0") == nodes[0][0]);
+    ensemble_config_free(ensemble_config);
+}
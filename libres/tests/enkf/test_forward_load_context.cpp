@@ -0,0 +1,90 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/forward_load_context.hpp>
+#include <ert/enkf/run_arg.hpp>
+#include <ert/res_util/subst_list.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+void touch(const fs::path &file) {
+    fs::create_directories(file.parent_path());
+    std::ofstream{file};
+}
+} // namespace
+
+TEST_CASE("forward_load_context_file_exists", "[enkf]") {
+    WITH_TMPDIR;
+    touch("run0/gen_data_0.out");
+    touch("run0/gen_data_1.out");
+    touch("run0/sub/result.txt");
+    touch("run1/gen_data_2.out");
+    fs::create_symlink("gen_data_0.out", "run0/link.out");
+    fs::create_symlink("missing.out", "run0/dangling.out");
+
+    subst_list_type *subst_list = subst_list_alloc(NULL);
+    run_arg_type *run_arg0 = run_arg_alloc_ENSEMBLE_EXPERIMENT(
+        "run_id", NULL, 0, 0, "run0", "BASE", subst_list);
+    forward_load_context_type *load_context =
+        forward_load_context_alloc(run_arg0, false, NULL);
+
+    THEN("The files of the runpath are found") {
+        for (const char *file : {"run0/gen_data_0.out", "run0/gen_data_1.out",
+                                 "run0/sub/result.txt", "run0/link.out"})
+            REQUIRE(forward_load_context_file_exists(load_context, file));
+    }
+
+    THEN("Missing files are not found") {
+        for (const char *file :
+             {"run0/gen_data_2.out", "run0/dangling.out",
+              "run0/missing/result.txt", "run0/sub/gen_data_0.out"})
+            REQUIRE_FALSE(forward_load_context_file_exists(load_context, file));
+    }
+
+    GIVEN("Files which are created after the runpath was listed") {
+        REQUIRE_FALSE(
+            forward_load_context_file_exists(load_context, "run0/new.out"));
+        touch("run0/new.out");
+
+        THEN("They are not seen by the same load context") {
+            REQUIRE_FALSE(
+                forward_load_context_file_exists(load_context, "run0/new.out"));
+        }
+
+        THEN("They are seen when the runpath is loaded again") {
+            forward_load_context_type *reload_context =
+                forward_load_context_alloc(run_arg0, false, NULL);
+            REQUIRE(forward_load_context_file_exists(reload_context,
+                                                     "run0/new.out"));
+            forward_load_context_free(reload_context);
+        }
+    }
+
+    GIVEN("Another runpath") {
+        run_arg_type *run_arg1 = run_arg_alloc_ENSEMBLE_EXPERIMENT(
+            "run_id", NULL, 1, 0, "run1", "BASE", subst_list);
+        forward_load_context_type *other_context =
+            forward_load_context_alloc(run_arg1, false, NULL);
+
+        THEN("The files of that runpath are found") {
+            REQUIRE(forward_load_context_file_exists(other_context,
+                                                     "run1/gen_data_2.out"));
+            REQUIRE_FALSE(forward_load_context_file_exists(
+                other_context, "run1/gen_data_0.out"));
+            REQUIRE(forward_load_context_file_exists(load_context,
+                                                     "run0/gen_data_0.out"));
+        }
+        forward_load_context_free(other_context);
+        run_arg_free(run_arg1);
+    }
+
+    forward_load_context_free(load_context);
+    run_arg_free(run_arg0);
+    subst_list_free(subst_list);
+}
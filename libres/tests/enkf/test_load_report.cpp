@@ -0,0 +1,61 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "../tmpdir.hpp"
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/load_report.hpp>
+
+TEST_CASE("load_report sums the phases of the realizations", "[enkf]") {
+    ert::utils::Profile profile0;
+    profile0.add_time("summary.read", 1.5);
+    profile0.add_bytes("summary.read", 1024);
+    profile0.add_time("enkf_fs.write", 0.25);
+
+    ert::utils::Profile profile1;
+    profile1.add_time("summary.read", 0.5);
+    profile1.add_bytes("summary.read", 512);
+
+    ert::load_report report;
+    REQUIRE(report.size() == 0);
+    report.add(1, LOAD_FAILURE, profile1);
+    report.add(0, LOAD_SUCCESSFUL, profile0);
+    REQUIRE(report.size() == 2);
+
+    const std::string json = report.to_json();
+    REQUIRE(json == "{\"realizations\": {\n"
+                    "  \"0\": {\"status\": \"LOAD_SUCCESSFUL\", \"phases\": {\n"
+                    "    \"enkf_fs.write\": {\"seconds\": 0.250000, "
+                    "\"calls\": 1, \"bytes\": 0},\n"
+                    "    \"summary.read\": {\"seconds\": 1.500000, "
+                    "\"calls\": 1, \"bytes\": 1024}}},\n"
+                    "  \"1\": {\"status\": \"LOAD_FAILURE\", \"phases\": {\n"
+                    "    \"summary.read\": {\"seconds\": 0.500000, "
+                    "\"calls\": 1, \"bytes\": 512}}}},\n"
+                    "\"total\": {\n"
+                    "    \"enkf_fs.write\": {\"seconds\": 0.250000, "
+                    "\"calls\": 1, \"bytes\": 0},\n"
+                    "    \"summary.read\": {\"seconds\": 2.000000, "
+                    "\"calls\": 2, \"bytes\": 1536}}}\n");
+
+    WHEN("A realization is loaded again") {
+        report.add(1, LOAD_SUCCESSFUL, ert::utils::Profile());
+        THEN("Its profile is replaced") {
+            REQUIRE(report.size() == 2);
+            REQUIRE(report.to_json().find("\"1\": {\"status\": "
+                                          "\"LOAD_SUCCESSFUL\", \"phases\": "
+                                          "{}}") != std::string::npos);
+        }
+    }
+
+    WHEN("The report is written") {
+        WITH_TMPDIR;
+        report.fwrite("load-report.json");
+        std::ifstream stream("load-report.json");
+        std::stringstream content;
+        content << stream.rdbuf();
+        REQUIRE(content.str() == json);
+        REQUIRE_FALSE(std::filesystem::exists("load-report.json.tmp"));
+    }
+}
@@ -0,0 +1,54 @@
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/load_service.hpp>
+
+TEST_CASE("load_service", "[enkf]") {
+    GIVEN("A service with a loader which fails every third realization") {
+        std::atomic<int> calls = 0;
+        ert::load_service service(
+            4, [&calls](const res_config_type *, run_arg_type *) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                return calls++ % 3 != 0;
+            });
+
+        WHEN("Realizations are submitted") {
+            std::vector<std::future<bool>> results;
+            for (int i = 0; i < 30; i++)
+                results.push_back(service.submit(nullptr, nullptr));
+
+            THEN("All have been loaded when wait() returns") {
+                service.wait();
+                REQUIRE(service.submitted() == 30);
+                REQUIRE(service.loaded() == 20);
+                REQUIRE(service.failed() == 10);
+                REQUIRE(service.pending() == 0);
+
+                int ok = 0;
+                for (auto &result : results)
+                    ok += result.get();
+                REQUIRE(ok == 20);
+            }
+        }
+    }
+
+    GIVEN("A service with a loader which throws") {
+        ert::load_service service(2, [](const res_config_type *,
+                                         run_arg_type *) -> bool {
+            throw std::invalid_argument("corrupt result file");
+        });
+
+        THEN("The exception is delivered and counted as a failure") {
+            auto result = service.submit(nullptr, nullptr);
+            REQUIRE_THROWS_AS(result.get(), std::invalid_argument);
+            service.wait();
+            REQUIRE(service.failed() == 1);
+            REQUIRE(service.pending() == 0);
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#include <fstream>
+
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/load_sources.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace {
+void write_file(const char *filename, const std::string &content) {
+    std::ofstream stream(filename, std::ios::binary);
+    stream << content;
+}
+} // namespace
+
+TEST_CASE("source_fingerprint", "[enkf]") {
+    WITH_TMPDIR;
+    write_file("RESULT", "0.1 0.2 0.3");
+    auto fingerprint =
+        ert::source_fingerprint::of_files({"RESULT", "RESULT_active"}, "ctx");
+
+    THEN("It is the same for the same files and context") {
+        REQUIRE(fingerprint.size == 11);
+        REQUIRE(fingerprint == ert::source_fingerprint::of_files(
+                                   {"RESULT", "RESULT_active"}, "ctx"));
+    }
+
+    THEN("It changes with the context") {
+        REQUIRE(fingerprint != ert::source_fingerprint::of_files(
+                                   {"RESULT", "RESULT_active"}, "other"));
+    }
+
+    THEN("It changes with the content, also when the size does not") {
+        auto mtime = std::filesystem::last_write_time("RESULT");
+        write_file("RESULT", "0.1 0.2 0.4");
+        std::filesystem::last_write_time("RESULT", mtime);
+        REQUIRE(fingerprint != ert::source_fingerprint::of_files(
+                                   {"RESULT", "RESULT_active"}, "ctx"));
+    }
+
+    THEN("It changes when a missing file is created") {
+        write_file("RESULT_active", "");
+        REQUIRE(fingerprint != ert::source_fingerprint::of_files(
+                                   {"RESULT", "RESULT_active"}, "ctx"));
+    }
+
+    THEN("Without the content it only has the size and modification time") {
+        auto stat = ert::source_fingerprint::stat_files(
+            {"RESULT", "RESULT_active"}, "ctx");
+        auto mtime = std::filesystem::last_write_time("RESULT");
+        write_file("RESULT", "0.1 0.2 0.4");
+        std::filesystem::last_write_time("RESULT", mtime);
+        REQUIRE(stat == ert::source_fingerprint::stat_files(
+                            {"RESULT", "RESULT_active"}, "ctx"));
+
+        stat.hash_samples({"RESULT", "RESULT_active"});
+        REQUIRE(stat != fingerprint);
+        REQUIRE(stat == ert::source_fingerprint::of_files(
+                            {"RESULT", "RESULT_active"}, "ctx"));
+    }
+}
+
+TEST_CASE("load_sources of result_files", "[enkf]") {
+    WITH_TMPDIR;
+    write_file("RESULT", "0.1 0.2 0.3");
+    ert::load_sources sources;
+    ert::result_files files({"RESULT", "RESULT_active"}, "ctx");
+
+    THEN("Files without a record are not unchanged") {
+        REQUIRE(!sources.unchanged("RESULT:1", files));
+    }
+
+    sources.set("RESULT:1", files);
+    THEN("Files with the recorded fingerprint are unchanged") {
+        REQUIRE(sources.unchanged("RESULT:1", files));
+        REQUIRE(sources.unchanged("RESULT:1", files.fingerprint()));
+        REQUIRE(sources.unchanged(
+            "RESULT:1", ert::result_files({"RESULT", "RESULT_active"}, "ctx")));
+    }
+
+    THEN("Files with a changed content, size or mtime are not unchanged") {
+        auto mtime = std::filesystem::last_write_time("RESULT");
+        write_file("RESULT", "0.1 0.2 0.4");
+        std::filesystem::last_write_time("RESULT", mtime);
+        REQUIRE(!sources.unchanged(
+            "RESULT:1", ert::result_files({"RESULT", "RESULT_active"}, "ctx")));
+
+        write_file("RESULT", "0.1 0.2 0.3 0.4");
+        REQUIRE(!sources.unchanged(
+            "RESULT:1", ert::result_files({"RESULT", "RESULT_active"}, "ctx")));
+    }
+}
+
+TEST_CASE("load_sources", "[enkf]") {
+    ert::source_fingerprint fingerprint{100, 12345, 0xabcdef};
+    ert::load_sources sources;
+    sources.set("SNAKE_OIL:1", fingerprint);
+
+    REQUIRE(sources.unchanged("SNAKE_OIL:1", fingerprint));
+    REQUIRE(!sources.unchanged("SNAKE_OIL:2", fingerprint));
+    REQUIRE(!sources.unchanged("SNAKE_OIL:1", {100, 12346, 0xabcdef}));
+
+    auto buffer = buffer_alloc(100);
+    sources.fwrite(buffer);
+    buffer_rewind(buffer);
+
+    ert::load_sources loaded;
+    loaded.fread(buffer);
+    REQUIRE(loaded.unchanged("SNAKE_OIL:1", fingerprint));
+
+    loaded.erase("SNAKE_OIL:1");
+    REQUIRE(!loaded.unchanged("SNAKE_OIL:1", fingerprint));
+    buffer_free(buffer);
+}
@@ -30,3 +30,25 @@ TEST_CASE("meas_block_calculate_ens_stats", "[meas_data]") {
     REQUIRE(meas_block_iget_ens_mean(mb, 2) == 4.5);
     REQUIRE(meas_block_iget_ens_std(mb, 2) == 1.5);
 }
+
+TEST_CASE("meas_block_iset_gather", "[meas_data]") {
+    int ens_size = 3;
+    std::vector<bool> ens_mask{true, false, true};
+    int obs_size = 4;
+    auto *mb = meas_block_alloc("OBS1", ens_mask, obs_size);
+
+    std::vector<float> data{10, 11, 12, 13, 14, 15};
+    std::vector<int> obs_index{0, 1, 3};
+    std::vector<int> data_index{5, 2, 0};
+    meas_block_iset_gather(mb, 2, obs_index, data_index, data.data());
+
+    REQUIRE(meas_block_iget(mb, 2, 0) == 15);
+    REQUIRE(meas_block_iget(mb, 2, 1) == 12);
+    REQUIRE(meas_block_iget(mb, 2, 3) == 10);
+
+    REQUIRE(meas_block_iget_active(mb, 0));
+    REQUIRE(meas_block_iget_active(mb, 1));
+    REQUIRE(!meas_block_iget_active(mb, 2));
+    REQUIRE(meas_block_iget_active(mb, 3));
+    meas_block_free(mb);
+}
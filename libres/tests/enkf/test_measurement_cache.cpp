@@ -0,0 +1,50 @@
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/measurement_cache.hpp>
+
+namespace {
+std::shared_ptr<const ert::measurement> make_measurement(int obs_size) {
+    auto measured = std::make_shared<ert::measurement>();
+    measured->blocks.emplace_back(
+        1, std::shared_ptr<const meas_block_type>(
+               meas_block_alloc("OBS", {true, true}, obs_size),
+               meas_block_free));
+    return measured;
+}
+} // namespace
+
+TEST_CASE("measurement_cache", "[enkf]") {
+    const std::vector<int> ens_active_list{0, 1};
+    ert::measurement_cache cache(1024);
+
+    GIVEN("A cached measurement") {
+        auto measured = make_measurement(4);
+        cache.put("OBS", 1, 7, ens_active_list, measured);
+
+        THEN("It is returned for the same key, version and generation") {
+            REQUIRE(cache.get("OBS", 1, 7, ens_active_list) == measured);
+        }
+
+        THEN("It is not returned when anything has changed") {
+            REQUIRE(cache.get("OTHER", 1, 7, ens_active_list) == nullptr);
+            REQUIRE(cache.get("OBS", 2, 7, ens_active_list) == nullptr);
+            REQUIRE(cache.get("OBS", 1, 8, ens_active_list) == nullptr);
+            REQUIRE(cache.get("OBS", 1, 7, {1}) == nullptr);
+        }
+
+        WHEN("A measurement for a newer generation is stored") {
+            cache.put("OTHER", 1, 8, ens_active_list, make_measurement(4));
+            THEN("The older generation is dropped") {
+                REQUIRE(cache.get("OBS", 1, 7, ens_active_list) == nullptr);
+                REQUIRE(cache.get("OTHER", 1, 8, ens_active_list) != nullptr);
+            }
+        }
+    }
+
+    GIVEN("A measurement larger than the cache") {
+        cache.put("OBS", 1, 7, ens_active_list, make_measurement(1000));
+        THEN("It is not stored") {
+            REQUIRE(cache.get("OBS", 1, 7, ens_active_list) == nullptr);
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/summary_key_matcher.hpp>
+
+TEST_CASE("summary_key_matcher", "[enkf]") {
+    auto matcher = summary_key_matcher_alloc();
+    summary_key_matcher_add_summary_key(matcher, "FOPR");
+    summary_key_matcher_add_summary_key(matcher, "WOPR:*");
+    summary_key_matcher_add_summary_key(matcher, "W?PT:OP1");
+    summary_key_matcher_add_summary_key(matcher, "*:P2");
+
+    const std::vector<std::string> keys{"FOPR",     "FOPT",     "WOPR:OP1",
+                                        "WWPT:OP1", "WWPT:OP2", "BPR:P2",
+                                        "WOP"};
+    const std::vector<bool> expected{true, false, true, true,
+                                     false, true, false};
+
+    THEN("Exact keys and wildcard patterns are matched") {
+        for (size_t i = 0; i < keys.size(); i++)
+            REQUIRE(summary_key_matcher_match_summary_key(
+                        matcher, keys[i].c_str()) == expected[i]);
+        REQUIRE(!summary_key_matcher_match_summary_key(matcher, nullptr));
+    }
+
+    THEN("A list of keys is matched once") {
+        auto matched = summary_key_matcher_match_summary_keys(matcher, keys);
+        REQUIRE(*matched == expected);
+        REQUIRE(summary_key_matcher_match_summary_keys(matcher, keys) ==
+                matched);
+
+        summary_key_matcher_add_summary_key(matcher, "FOPT");
+        auto rematched = summary_key_matcher_match_summary_keys(matcher, keys);
+        REQUIRE(rematched != matched);
+        REQUIRE((*rematched)[1]);
+    }
+
+    THEN("A node without a key is not matched") {
+        summary_key_matcher_add_summary_key(matcher, "*");
+        REQUIRE(!summary_key_matcher_match_summary_key(matcher, ""));
+        auto matched =
+            summary_key_matcher_match_summary_keys(matcher, {"FOPT", ""});
+        REQUIRE(*matched == std::vector<bool>{true, false});
+    }
+
+    summary_key_matcher_free(matcher);
+}
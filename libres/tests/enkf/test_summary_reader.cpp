@@ -0,0 +1,104 @@
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/summary_reader.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace {
+void write_int(std::ofstream &stream, uint32_t value) {
+    const char bytes[4] = {char(value >> 24), char(value >> 16),
+                           char(value >> 8), char(value)};
+    stream.write(bytes, sizeof bytes);
+}
+
+void write_header(std::ofstream &stream, const std::string &name, int count,
+                  const std::string &type) {
+    write_int(stream, 16);
+    stream.write(name.data(), 8);
+    write_int(stream, count);
+    stream.write(type.data(), 4);
+    write_int(stream, 16);
+}
+
+void write_int_keyword(std::ofstream &stream, const std::string &name,
+                       int value) {
+    write_header(stream, name, 1, "INTE");
+    write_int(stream, 4);
+    write_int(stream, value);
+    write_int(stream, 4);
+}
+
+/** PARAMS with the values first + i, in records of at most 1000 values. */
+void write_params(std::ofstream &stream, int count, float first) {
+    write_header(stream, "PARAMS  ", count, "REAL");
+    for (int offset = 0; offset < count; offset += 1000) {
+        int record_count = std::min(1000, count - offset);
+        write_int(stream, record_count * 4);
+        for (int i = offset; i < offset + record_count; i++) {
+            float value = first + i;
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof bits);
+            write_int(stream, bits);
+        }
+        write_int(stream, record_count * 4);
+    }
+}
+} // namespace
+
+TEST_CASE("fread_summary_columns", "[enkf]") {
+    WITH_TMPDIR;
+    const int params_size = 2500;
+    {
+        std::ofstream stream("CASE.UNSMRY", std::ios::binary);
+        for (int report_step = 1; report_step <= 2; report_step++) {
+            write_int_keyword(stream, "SEQHDR  ", 0);
+            for (int ministep = 0; ministep < 2; ministep++) {
+                write_int_keyword(stream, "MINISTEP", ministep);
+                write_params(stream, params_size,
+                             10000 * report_step + ministep);
+            }
+        }
+    }
+
+    GIVEN("Columns in different PARAMS records, out of order") {
+        const std::vector<int> params_index{2400, 0, 999, 1000};
+        ert::summary_columns_data data;
+        REQUIRE(ert::fread_summary_columns("CASE.UNSMRY", params_size,
+                                           params_index, data));
+
+        THEN("Each ministep is assigned to its report step") {
+            REQUIRE(data.report_steps == std::vector<int>{1, 1, 2, 2});
+        }
+
+        THEN("The values are in the order of params_index") {
+            REQUIRE(data.values.size() == params_index.size());
+            for (size_t i = 0; i < params_index.size(); i++)
+                REQUIRE(data.values[i] ==
+                        std::vector<float>{10000.0f + params_index[i],
+                                           10001.0f + params_index[i],
+                                           20000.0f + params_index[i],
+                                           20001.0f + params_index[i]});
+        }
+    }
+
+    THEN("A file with a different number of PARAMS is not read") {
+        ert::summary_columns_data data;
+        REQUIRE(!ert::fread_summary_columns("CASE.UNSMRY", params_size + 1,
+                                            {0}, data));
+    }
+
+    THEN("A truncated file is not read") {
+        std::filesystem::resize_file("CASE.UNSMRY",
+                                     std::filesystem::file_size("CASE.UNSMRY") -
+                                         10);
+        ert::summary_columns_data data;
+        REQUIRE(!ert::fread_summary_columns("CASE.UNSMRY", params_size, {0},
+                                            data));
+    }
+}
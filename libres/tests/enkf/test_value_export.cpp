@@ -0,0 +1,88 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../tmpdir.hpp"
+#include "catch2/catch.hpp"
+#include <ert/enkf/value_export.hpp>
+
+namespace fs = std::filesystem;
+
+namespace {
+std::string read_file(const fs::path &filename) {
+    std::ifstream stream(filename);
+    std::stringstream content;
+    content << stream.rdbuf();
+    return content.str();
+}
+
+void append_values(value_export_type *export_value, double offset) {
+    value_export_append(export_value, "KEY2", "SUBKEY1", 0.1 + offset);
+    value_export_append(export_value, "KEY1", "SUBKEY2", 1e-5 + offset);
+    value_export_append(export_value, "KEY1", "SUBKEY1", 1.0 / 3 + offset);
+}
+} // namespace
+
+TEST_CASE("value_export writes the values sorted on key and subkey",
+          "[enkf]") {
+    WITH_TMPDIR;
+    value_export_type *export_value = value_export_alloc(".", "parameters");
+    append_values(export_value, 0);
+    REQUIRE(value_export_size(export_value) == 3);
+    value_export(export_value);
+
+    REQUIRE(read_file("parameters.txt") == "KEY1:SUBKEY1 0.3333333333333333\n"
+                                           "KEY1:SUBKEY2 1e-05\n"
+                                           "KEY2:SUBKEY1 0.1\n");
+    REQUIRE(read_file("parameters.json") ==
+            "{\n"
+            "\"KEY1\" : {\n"
+            "\"SUBKEY1\" : 0.3333333333333333,\n"
+            "\"SUBKEY2\" : 1e-05\n"
+            "},\n"
+            "\"KEY2\" : {\n"
+            "\"SUBKEY1\" : 0.1\n"
+            "},\n"
+            "\"KEY1:SUBKEY1\" : 0.3333333333333333,\n"
+            "\"KEY1:SUBKEY2\" : 1e-05,\n"
+            "\"KEY2:SUBKEY1\" : 0.1\n"
+            "}\n");
+
+    auto layout = value_export_get_layout(export_value);
+    value_export_free(export_value);
+
+    GIVEN("The layout of the first realization") {
+        fs::create_directory("run1");
+        value_export_type *export_value =
+            value_export_alloc("run1", "parameters");
+        value_export_set_layout(export_value, layout);
+
+        WHEN("The same keys are appended") {
+            append_values(export_value, 1);
+            THEN("The layout is reused") {
+                REQUIRE(value_export_get_layout(export_value) == layout);
+                value_export_txt(export_value);
+                REQUIRE(read_file("run1/parameters.txt") ==
+                        "KEY1:SUBKEY1 1.3333333333333333\n"
+                        "KEY1:SUBKEY2 1.00001\n"
+                        "KEY2:SUBKEY1 1.1\n");
+            }
+        }
+
+        WHEN("Other keys are appended") {
+            value_export_append(export_value, "KEY2", "SUBKEY1", 2);
+            value_export_append(export_value, "KEY0", "SUBKEY1", 3);
+            value_export_append(export_value, "KEY2", "SUBKEY1", 4);
+            THEN("A new layout is used") {
+                REQUIRE(value_export_get_layout(export_value) != layout);
+                REQUIRE(value_export_size(export_value) == 2);
+                value_export_txt(export_value);
+                REQUIRE(read_file("run1/parameters.txt") ==
+                        "KEY0:SUBKEY1 3\n"
+                        "KEY2:SUBKEY1 4\n");
+            }
+        }
+        value_export_free(export_value);
+    }
+}
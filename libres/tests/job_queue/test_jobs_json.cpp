@@ -0,0 +1,75 @@
+#include <memory>
+#include <string>
+
+#include "catch2/catch.hpp"
+#include <ert/job_queue/ext_job.hpp>
+#include <ert/job_queue/jobs_json.hpp>
+#include <ert/res_util/subst_list.hpp>
+
+TEST_CASE("jobs_json fills the slots for each realization", "[job_queue]") {
+    auto mapping = std::make_shared<ert::jobs_json::default_mapping>();
+    (*mapping)["<DEFAULT>"] = "default";
+
+    ert::jobs_json json;
+    json.append("{\"executable\" : ");
+    json.append_string("run-<IENS>.sh");
+    json.append(",\n\"argList\" : [");
+    json.append_argument("<IENS>", mapping);
+    json.append(",");
+    json.append_argument("<DEFAULT>", mapping);
+    json.append("],\n\"environment\" : ");
+    json.append_hash({{"A", std::string("<IENS>")},
+                      {"B", std::string("<UNDEFINED>")},
+                      {"C", std::nullopt}},
+                     "null");
+    json.append(",\n\"exec_env\" : ");
+    json.append_hash({{"B", std::string("<UNDEFINED>")}}, "null");
+    json.append("}");
+
+    for (int iens = 0; iens < 2; iens++) {
+        subst_list_type *run_args = subst_list_alloc(NULL);
+        subst_list_append_copy(run_args, "<IENS>", std::to_string(iens).c_str(),
+                               NULL);
+        std::string i = std::to_string(iens);
+        REQUIRE(json.render(run_args) ==
+                "{\"executable\" : \"run-" + i +
+                    ".sh\",\n"
+                    "\"argList\" : [\"" +
+                    i +
+                    "\",\"default\"],\n"
+                    "\"environment\" : {\"A\" : \"" +
+                    i +
+                    "\",\"C\" : null},\n"
+                    "\"exec_env\" : null}");
+        subst_list_free(run_args);
+    }
+
+    REQUIRE(json.render(NULL).rfind("{\"executable\" : \"run-<IENS>.sh\"", 0) ==
+            0);
+}
+
+TEST_CASE("jobs_json fills the job strings with the run arguments",
+          "[job_queue]") {
+    ext_job_type *job = ext_job_alloc("JOB", nullptr, false);
+    ext_job_set_private_arg(job, "<INPUT>", "input.txt");
+    ext_job_set_stdin_file(job, "<INPUT>");
+    ext_job_set_stdout_file(job, "job.stdout");
+    ext_job_set_target_file(job, "<RUNPATH>/OK");
+    ext_job_set_start_file(job, "MULTIR_FILE");
+
+    ert::jobs_json json;
+    ext_job_json_append(job, 0, json);
+
+    // MULTIR_FILE is a key without the <> as from "DEFINE MULTIR_FILE ...".
+    subst_list_type *run_args = subst_list_alloc(NULL);
+    subst_list_append_copy(run_args, "<RUNPATH>", "run0", NULL);
+    subst_list_append_copy(run_args, "MULTIR_FILE", "multir.txt", NULL);
+    std::string rendered = json.render(run_args);
+    for (const char *entry :
+         {"\"stdin\" : \"input.txt\"", "\"stdout\" : \"job.stdout.0\"",
+          "\"target_file\" : \"run0/OK\"", "\"start_file\" : \"multir.txt\"",
+          "\"error_file\" : null"})
+        REQUIRE(rendered.find(entry) != std::string::npos);
+    subst_list_free(run_args);
+    ext_job_free(job);
+}
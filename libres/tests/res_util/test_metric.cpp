@@ -22,3 +22,26 @@ TEST_CASE("simple time benchmark test", "[res_util]") {
     REQUIRE(std::regex_search(logger->calls[0], std::regex("2\\.\\d{4}")));
     REQUIRE(logger->calls[0].find("some_function's") != std::string::npos);
 }
+
+TEST_CASE("ScopedTimer records into the current profile", "[res_util]") {
+    ert::utils::Profile profile;
+    {
+        ert::utils::ScopedTimer timer("outside");
+    }
+    {
+        ert::utils::ProfileScope scope(profile);
+        for (int i = 0; i < 2; i++) {
+            ert::utils::ScopedTimer timer("phase");
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        ert::utils::Profile::count_bytes("phase", 100);
+    }
+    ert::utils::Profile::count_bytes("phase", 100);
+
+    REQUIRE(ert::utils::Profile::current() == nullptr);
+    REQUIRE(profile.phases().size() == 1);
+    const auto &phase = profile.phases().at("phase");
+    REQUIRE(phase.calls == 2);
+    REQUIRE(phase.bytes == 100);
+    REQUIRE(phase.seconds >= 0.02);
+}
@@ -0,0 +1,86 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../tmpdir.hpp"
+#include "catch2/catch.hpp"
+#include <ert/res_util/runpath_manifest.hpp>
+
+namespace fs = std::filesystem;
+
+namespace {
+std::string read_file(const fs::path &filename) {
+    std::ifstream stream(filename);
+    std::stringstream content;
+    content << stream.rdbuf();
+    return content.str();
+}
+
+/** Replaces the content of file, keeping its size and modification time. */
+void replace_content(const fs::path &file, const std::string &content) {
+    auto mtime = fs::last_write_time(file);
+    std::ofstream(file) << content;
+    fs::last_write_time(file, mtime);
+}
+} // namespace
+
+TEST_CASE("runpath_manifest only writes changed files", "[res_util]") {
+    WITH_TMPDIR;
+    const fs::path runpath = "run";
+    const fs::path file = runpath / "sub" / "jobs.json";
+    const std::vector<std::string_view> spans{"{\"a\" : ", "1}\n"};
+
+    ert::runpath_manifest manifest(runpath);
+    REQUIRE_FALSE(manifest.unchanged(file, spans));
+    REQUIRE(manifest.write_file(file, spans));
+    REQUIRE(read_file(file) == "{\"a\" : 1}\n");
+    REQUIRE(manifest.unchanged(file, {"{\"a\" : 1}", "\n"}));
+
+    GIVEN("The same content") {
+        // A file which is not written keeps the replaced content.
+        replace_content(file, "{\"b\" : 2}\n");
+        REQUIRE(manifest.write_file(file, {"{\"a\" : 1}\n"}));
+        REQUIRE(read_file(file) == "{\"b\" : 2}\n");
+    }
+
+    GIVEN("Changed content") {
+        REQUIRE(manifest.write_file(file, {"{\"a\" : 2}\n"}));
+        REQUIRE(read_file(file) == "{\"a\" : 2}\n");
+        REQUIRE_FALSE(manifest.unchanged(file, spans));
+    }
+
+    GIVEN("A file which is modified after it was written") {
+        fs::last_write_time(file, fs::last_write_time(file) -
+                                      std::chrono::seconds(10));
+        REQUIRE_FALSE(manifest.unchanged(file, spans));
+        fs::remove(file);
+        REQUIRE(manifest.write_file(file, spans));
+        REQUIRE(read_file(file) == "{\"a\" : 1}\n");
+    }
+
+    GIVEN("A file which is written by other means") {
+        const fs::path other = runpath / "other";
+        std::ofstream(other) << "text";
+        manifest.add_file(other, {"text"});
+        REQUIRE(manifest.unchanged(other, {"te", "xt"}));
+        manifest.erase(other);
+        REQUIRE_FALSE(manifest.unchanged(other, {"text"}));
+    }
+
+    GIVEN("A saved manifest") {
+        manifest.save();
+        REQUIRE(fs::exists(runpath / ert::runpath_manifest::filename));
+
+        ert::runpath_manifest loaded(runpath);
+        REQUIRE(loaded.unchanged(file, spans));
+        REQUIRE_FALSE(ert::runpath_manifest("other").unchanged(file, spans));
+
+        std::ofstream(runpath / ert::runpath_manifest::filename)
+            << "not a manifest\n";
+        REQUIRE_FALSE(ert::runpath_manifest(runpath).unchanged(file, spans));
+    }
+}
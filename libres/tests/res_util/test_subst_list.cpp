@@ -0,0 +1,216 @@
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../tmpdir.hpp"
+#include "catch2/catch.hpp"
+#include <ert/res_util/subst_list.hpp>
+
+namespace {
+std::string filter(const subst_list_type *subst_list, const char *text) {
+    char *filtered = subst_list_alloc_filtered_string(subst_list, text);
+    std::string result = filtered;
+    free(filtered);
+    return result;
+}
+
+/** The substitutions one key at the time, as documented in subst_list. */
+std::string
+filter_reference(const std::vector<std::pair<std::string, std::string>> &subst,
+                 std::string text) {
+    for (const auto &[key, value] : subst) {
+        size_t pos = text.find(key);
+        while (pos != std::string::npos) {
+            text.replace(pos, key.size(), value);
+            pos = text.find(key, pos + value.size());
+        }
+    }
+    return text;
+}
+} // namespace
+
+TEST_CASE("subst_list replaces the keys", "[res_util]") {
+    subst_list_type *parent = subst_list_alloc(NULL);
+    subst_list_type *subst_list = subst_list_alloc(parent);
+    subst_list_append_copy(parent, "<CASE>", "base", NULL);
+    subst_list_append_copy(parent, "<IENS>", "7", NULL);
+    subst_list_append_copy(subst_list, "<CASE>", "other", NULL);
+    subst_list_append_copy(subst_list, "<ITER>", "2", NULL);
+
+    GIVEN("Magic strings in text") {
+        THEN("The parent values take precedence") {
+            REQUIRE(filter(subst_list, "<CASE>/r<IENS>/i<ITER> <X> a<b") ==
+                    "base/r7/i2 <X> a<b");
+            REQUIRE(filter(subst_list, "<<CASE>> <<IENS><ITER>") ==
+                    "<base> <72");
+        }
+    }
+
+    GIVEN("Values which contain keys") {
+        subst_list_append_copy(parent, "<PATH>", "/run/<ITER>", NULL);
+        subst_list_append_copy(subst_list, "A", "<CASE>", NULL);
+
+        THEN("They are substituted in order") {
+            REQUIRE(filter(subst_list, "<PATH>/<CASE>") == "/run/2/base");
+            REQUIRE(filter(subst_list, "A<CASE>") == "<CASE>base");
+        }
+    }
+
+    GIVEN("Keys which are joined by the substitutions") {
+        subst_list_append_copy(subst_list, "<A>", "B", NULL);
+        subst_list_append_copy(subst_list, "<C2B>", "joined", NULL);
+
+        THEN("The joined key is substituted") {
+            REQUIRE(filter(subst_list, "<C<ITER><A>>") == "joined");
+        }
+    }
+
+    GIVEN("A change of the parent") {
+        REQUIRE(filter(subst_list, "<IENS>") == "7");
+        subst_list_append_copy(parent, "<IENS>", "8", NULL);
+        THEN("The new value is used") {
+            REQUIRE(filter(subst_list, "<IENS>") == "8");
+        }
+
+        subst_list_clear(parent);
+        THEN("The keys of the parent are gone") {
+            REQUIRE(filter(subst_list, "<IENS><CASE>") == "<IENS>other");
+        }
+    }
+
+    subst_list_free(subst_list);
+    subst_list_free(parent);
+}
+
+TEST_CASE("subst_list is the same as the ordered substitutions",
+          "[res_util]") {
+    const std::vector<std::string> words{"<A>", "<B>", "<AB>", "<", ">",
+                                         "A",   "B",   "x",    "<A"};
+    std::mt19937 random(42);
+    auto pick = [&](size_t size) { return random() % size; };
+
+    for (int round = 0; round < 500; round++) {
+        std::vector<std::pair<std::string, std::string>> subst;
+        subst_list_type *subst_list = subst_list_alloc(NULL);
+        for (int i = 0; i < 3; i++) {
+            std::string key = words[pick(3)];
+            // Every other round without '<' and '>' in the values.
+            std::string value = round % 2 ? words[pick(words.size())]
+                                          : words[5 + pick(3)];
+            if (subst_list_has_key(subst_list, key.c_str()))
+                continue;
+            subst.emplace_back(key, value);
+            subst_list_append_copy(subst_list, key.c_str(), value.c_str(),
+                                   NULL);
+        }
+
+        std::string text;
+        for (int i = 0; i < 8; i++)
+            text += words[pick(words.size())];
+
+        INFO("text: " << text);
+        REQUIRE(filter(subst_list, text.c_str()) ==
+                filter_reference(subst, text));
+        subst_list_free(subst_list);
+    }
+}
+
+TEST_CASE("subst_list filters a file", "[res_util]") {
+    WITH_TMPDIR;
+    {
+        std::ofstream stream("template");
+        stream << "RUNPATH <RUNPATH>\nFOPR < 1000 <RUNPATH>\n";
+    }
+
+    subst_list_type *subst_list = subst_list_alloc(NULL);
+    subst_list_append_copy(subst_list, "<RUNPATH>", "/run/1", NULL);
+    REQUIRE(subst_list_filter_file(subst_list, "template", "sub/target"));
+
+    std::ifstream stream("sub/target");
+    std::stringstream content;
+    content << stream.rdbuf();
+    REQUIRE(content.str() == "RUNPATH /run/1\nFOPR < 1000 /run/1\n");
+    subst_list_free(subst_list);
+}
+
+TEST_CASE("subst_file_filter is the same as subst_list_filter_file",
+          "[res_util]") {
+    WITH_TMPDIR;
+    // The keys, the text around them, and the parts of a function call.
+    const std::vector<std::string> words{"<A>", "<B>",  "<AB>",     ">",
+                                         "A",   "x",    "__",       "ADD_",
+                                         "<",   "<A",   "_(1,2)\n"};
+    std::mt19937 random(42);
+    auto pick = [&](size_t size) { return random() % size; };
+    auto read_file = [](const char *filename) {
+        std::ifstream stream(filename);
+        std::stringstream content;
+        content << stream.rdbuf();
+        return content.str();
+    };
+
+    subst_func_pool_type *func_pool = subst_func_pool_alloc();
+    subst_func_pool_add_func(func_pool, "ADD", "Adds arguments",
+                             subst_func_add, true, 1, 0, NULL);
+    subst_list_type *parent = subst_list_alloc(func_pool);
+    subst_list_insert_func(parent, "ADD", "__ADD__");
+
+    for (int round = 0; round < 200; round++) {
+        // Every other round without a '<' which is not a key, or a part of
+        // the function name, in the text.
+        const size_t text_words = round % 2 ? words.size() : 6;
+        std::string text;
+        for (int i = 0; i < 40; i++)
+            text += words[pick(text_words)];
+        text += words.back();
+        {
+            std::ofstream stream("template");
+            stream << text;
+        }
+        ert::subst_file_filter file_filter("template");
+
+        for (int run = 0; run < 5; run++) {
+            subst_list_type *subst_list = subst_list_alloc(parent);
+            for (const char *key : {"<A>", "<B>", "<AB>"}) {
+                // Mostly without '<' and '>' in the values.
+                std::string value = pick(10) == 0 ? words[pick(words.size())]
+                                                  : words[4 + pick(4)];
+                subst_list_append_copy(subst_list, key, value.c_str(), NULL);
+            }
+
+            INFO("text: " << text);
+            bool expected_match =
+                subst_list_filter_file(subst_list, "template", "expected");
+            bool match = file_filter.filter(subst_list, "run/actual");
+            REQUIRE(read_file("run/actual") == read_file("expected"));
+            REQUIRE(match == expected_match);
+            subst_list_free(subst_list);
+        }
+    }
+    subst_list_free(parent);
+    subst_func_pool_free(func_pool);
+}
+
+TEST_CASE("subst_file_filter keeps the source as it was read", "[res_util]") {
+    WITH_TMPDIR;
+    {
+        std::ofstream stream("template");
+        stream << "RUNPATH <RUNPATH>\n";
+    }
+    ert::subst_file_filter file_filter("template");
+    // The user truncates the template while the runpaths are created.
+    std::ofstream("template").close();
+
+    subst_list_type *subst_list = subst_list_alloc(NULL);
+    subst_list_append_copy(subst_list, "<RUNPATH>", "/run/0", NULL);
+    REQUIRE(file_filter.filter(subst_list, "target"));
+
+    std::ifstream stream("target");
+    std::stringstream content;
+    content << stream.rdbuf();
+    REQUIRE(content.str() == "RUNPATH /run/0\n");
+    subst_list_free(subst_list);
+}
@@ -0,0 +1,103 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../tmpdir.hpp"
+#include "catch2/catch.hpp"
+#include <ert/res_util/subst_list.hpp>
+#include <ert/res_util/template.hpp>
+
+namespace fs = std::filesystem;
+
+namespace {
+void write_file(const char *filename, const std::string &content) {
+    std::ofstream stream(filename);
+    stream << content;
+}
+
+std::string read_file(const char *filename) {
+    std::ifstream stream(filename);
+    std::stringstream content;
+    content << stream.rdbuf();
+    return content.str();
+}
+} // namespace
+
+TEST_CASE("template_instantiate reuses the template content", "[res_util]") {
+    WITH_TMPDIR;
+    write_file("template-1", "<ARG> <IENS>\n");
+    write_file("template-2", "<IENS> <ARG>\n");
+
+    subst_list_type *parent = subst_list_alloc(NULL);
+    subst_list_append_copy(parent, "<ARG>", "parent", NULL);
+    template_type *template_ = template_alloc("template-<IENS>", false, parent);
+    subst_list_type *run_args = subst_list_alloc(NULL);
+
+    for (int iens = 1; iens <= 2; iens++) {
+        subst_list_append_copy(run_args, "<IENS>",
+                               std::to_string(iens).c_str(), NULL);
+        template_instantiate(template_, "target-<IENS>", run_args, false);
+    }
+    REQUIRE(read_file("target-1") == "parent 1\n");
+    REQUIRE(read_file("target-2") == "2 parent\n");
+
+    GIVEN("Changed arguments") {
+        subst_list_append_copy(parent, "<ARG>", "changed", NULL);
+        template_instantiate(template_, "target-<IENS>", run_args, false);
+        THEN("The new value is used") {
+            REQUIRE(read_file("target-2") == "2 changed\n");
+        }
+    }
+
+    GIVEN("A changed template file") {
+        write_file("template-2", "<IENS> <ARG> with a change\n");
+        auto mtime = fs::last_write_time("template-2");
+        fs::last_write_time("template-2", mtime + std::chrono::seconds(1));
+        template_instantiate(template_, "target-<IENS>", run_args, false);
+        THEN("The new content is used") {
+            REQUIRE(read_file("target-2") == "2 parent with a change\n");
+        }
+    }
+
+    GIVEN("A template file which depends on the run arguments") {
+        auto mtime = fs::last_write_time("template-2");
+        write_file("template-2", "<ARG> <IENS>\n");
+        fs::last_write_time("template-2", mtime);
+        template_instantiate(template_, "target-<IENS>", run_args, false);
+        THEN("Its content is not kept in the template") {
+            REQUIRE(read_file("target-2") == "parent 2\n");
+        }
+    }
+
+    subst_list_free(run_args);
+    template_free(template_);
+    subst_list_free(parent);
+}
+
+TEST_CASE("template_instantiate clones the realization invariant instances",
+          "[res_util]") {
+    WITH_TMPDIR;
+    write_file("template", "<ARG> only\n");
+
+    subst_list_type *parent = subst_list_alloc(NULL);
+    subst_list_append_copy(parent, "<ARG>", "parent", NULL);
+    template_type *template_ = template_alloc("template", true, parent);
+    subst_list_type *run_args = subst_list_alloc(parent);
+    subst_list_append_copy(run_args, "<IENS>", "0", NULL);
+
+    template_instantiate(template_, "run-0/target", run_args, true);
+    template_instantiate(template_, "run-1/target", run_args, true);
+    REQUIRE(read_file("run-1/target") == "parent only\n");
+
+    // A forward model job updates the file of the first realization.
+    write_file("run-0/target", "updated\n");
+    template_instantiate(template_, "run-2/target", run_args, true);
+    REQUIRE(read_file("run-1/target") == "parent only\n");
+    REQUIRE(read_file("run-2/target") == "parent only\n");
+
+    subst_list_free(run_args);
+    template_free(template_);
+    subst_list_free(parent);
+}
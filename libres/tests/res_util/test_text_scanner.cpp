@@ -0,0 +1,93 @@
+#include <fstream>
+#include <string>
+
+#include "../tmpdir.hpp"
+#include "catch2/catch.hpp"
+#include <ert/res_util/text_scanner.hpp>
+
+TEST_CASE("text_scanner scans as fscanf", "[res_util]") {
+    GIVEN("Whitespace separated values") {
+        auto scanner =
+            ert::text_scanner::from_string("  1 +2\t-3\n4.5e1 0.25\n\nword 7 ");
+
+        THEN("They are scanned in order, with their positions") {
+            int i;
+            REQUIRE(scanner.scan(i));
+            REQUIRE(i == 1);
+            REQUIRE(scanner.scan(i));
+            REQUIRE(i == 2);
+            REQUIRE(scanner.scan(i));
+            REQUIRE(i == -3);
+            REQUIRE(scanner.line() == 1);
+            REQUIRE(scanner.column() == 10);
+
+            double d;
+            REQUIRE(scanner.scan(d));
+            REQUIRE(d == 45.0);
+            float f;
+            REQUIRE(scanner.scan(f));
+            REQUIRE(f == 0.25f);
+
+            std::string word;
+            REQUIRE(scanner.scan(word));
+            REQUIRE(word == "word");
+            REQUIRE(scanner.line() == 4);
+            REQUIRE(scanner.column() == 5);
+
+            REQUIRE(scanner.scan(i));
+            REQUIRE(i == 7);
+            REQUIRE(scanner.at_end());
+            REQUIRE_FALSE(scanner.scan(i));
+            REQUIRE_FALSE(scanner.scan(word));
+        }
+    }
+
+    GIVEN("A value which does not match the conversion") {
+        auto scanner = ert::text_scanner::from_string("1.5 +x");
+
+        THEN("The int stops where the conversion stops") {
+            int i;
+            REQUIRE(scanner.scan(i));
+            REQUIRE(i == 1);
+            REQUIRE_FALSE(scanner.scan(i));
+            REQUIRE(scanner.column() == 2);
+
+            double d;
+            REQUIRE(scanner.scan(d));
+            REQUIRE(d == 0.5);
+            REQUIRE_FALSE(scanner.scan(i));
+            REQUIRE_FALSE(scanner.scan(d));
+            REQUIRE_FALSE(scanner.at_end());
+            REQUIRE(scanner.column() == 5);
+        }
+    }
+
+    GIVEN("A value out of the int range") {
+        auto scanner = ert::text_scanner::from_string("99999999999");
+
+        THEN("It is not scanned") {
+            int i;
+            REQUIRE_FALSE(scanner.scan(i));
+            REQUIRE_FALSE(scanner.at_end());
+        }
+    }
+}
+
+TEST_CASE("text_scanner reads a file", "[res_util]") {
+    WITH_TMPDIR;
+    {
+        std::ofstream stream("values.txt");
+        stream << "0.5\n1.5\n";
+    }
+
+    ert::text_scanner scanner("values.txt");
+    double value;
+    REQUIRE(scanner.scan(value));
+    REQUIRE(scanner.scan(value));
+    REQUIRE(value == 1.5);
+    REQUIRE(scanner.at_end());
+
+    scanner.rewind();
+    REQUIRE(scanner.scan(value));
+    REQUIRE(value == 0.5);
+}
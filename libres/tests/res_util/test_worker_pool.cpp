@@ -0,0 +1,44 @@
+#include <atomic>
+#include <stdexcept>
+
+#include "catch2/catch.hpp"
+
+#include <ert/concurrency.hpp>
+
+TEST_CASE("worker_pool", "[res_util]") {
+    GIVEN("A pool with a few threads") {
+        ert::worker_pool pool(3);
+        REQUIRE(pool.size() == 3);
+
+        THEN("The results are delivered in submission order") {
+            std::vector<std::future<int>> futures;
+            for (int i = 0; i < 100; i++)
+                futures.push_back(pool.submit([i] { return i * i; }));
+
+            for (int i = 0; i < 100; i++)
+                REQUIRE(futures[i].get() == i * i);
+        }
+
+        THEN("Exceptions are delivered through the future") {
+            auto future =
+                pool.submit([]() -> int { throw std::runtime_error("fail"); });
+            REQUIRE_THROWS_AS(future.get(), std::runtime_error);
+        }
+    }
+
+    GIVEN("Submitted tasks when the pool is destroyed") {
+        std::atomic<int> completed{0};
+        {
+            ert::worker_pool pool(2);
+            for (int i = 0; i < 20; i++)
+                pool.submit([&completed] { completed++; });
+        }
+        THEN("All of them have completed") { REQUIRE(completed == 20); }
+    }
+
+    THEN("The I/O bound size is limited") {
+        REQUIRE(ert::worker_pool::io_bound_size(1) == 1);
+        REQUIRE(ert::worker_pool::io_bound_size(0) == 1);
+        REQUIRE(ert::worker_pool::io_bound_size(1000) >= 4);
+    }
+}
@@ -36,7 +36,7 @@ class AnalysisConfig(BaseCClass):
     _alloc_full = ResPrototype(
         "void* analysis_config_alloc_full(double, bool, "
         "int, char*, double, bool, bool, "
-        "double, int, int)",
+        "double, int, int, int, int, double)",
         bind=False,
     )
 
@@ -101,6 +101,15 @@ class AnalysisConfig(BaseCClass):
     _get_min_realizations = ResPrototype(
         "int analysis_config_get_min_realisations(analysis_config)"
     )
+    _get_obs_reduction_min_size = ResPrototype(
+        "int analysis_config_get_obs_reduction_min_size(analysis_config)"
+    )
+    _get_obs_reduction_block_size = ResPrototype(
+        "int analysis_config_get_obs_reduction_block_size(analysis_config)"
+    )
+    _get_obs_reduction_variance = ResPrototype(
+        "double analysis_config_get_obs_reduction_variance(analysis_config)"
+    )
 
     def __init__(
         self,
@@ -161,6 +170,9 @@ class AnalysisConfig(BaseCClass):
                 config_dict.get(ConfigKeys.GLOBAL_STD_SCALING, 1.0),
                 config_dict.get(ConfigKeys.MAX_RUNTIME, 0),
                 config_dict.get(ConfigKeys.MIN_REALIZATIONS, 0),
+                config_dict.get(ConfigKeys.OBS_REDUCTION_MIN_SIZE, 0),
+                config_dict.get(ConfigKeys.OBS_REDUCTION_BLOCK_SIZE, 0),
+                config_dict.get(ConfigKeys.OBS_REDUCTION_VARIANCE, 0.99),
             )
             if c_ptr:
                 super().__init__(c_ptr)
@@ -219,6 +231,15 @@ class AnalysisConfig(BaseCClass):
     def setStdCutoff(self, std_cutoff):
         self._set_std_cutoff(std_cutoff)
 
+    def get_obs_reduction_min_size(self) -> int:
+        return self._get_obs_reduction_min_size()
+
+    def get_obs_reduction_block_size(self) -> int:
+        return self._get_obs_reduction_block_size()
+
+    def get_obs_reduction_variance(self) -> float:
+        return self._get_obs_reduction_variance()
+
     def getAnalysisIterConfig(self) -> AnalysisIterConfig:
         """@rtype: AnalysisIterConfig"""
         return self._get_iter_config().setParent(self)
@@ -295,6 +316,15 @@ class AnalysisConfig(BaseCClass):
         if self.getStdCutoff() != other.getStdCutoff():
             return False
 
+        if self.get_obs_reduction_min_size() != other.get_obs_reduction_min_size():
+            return False
+
+        if self.get_obs_reduction_block_size() != other.get_obs_reduction_block_size():
+            return False
+
+        if self.get_obs_reduction_variance() != other.get_obs_reduction_variance():
+            return False
+
         if self.getEnkfAlpha() != other.getEnkfAlpha():
             return False
 
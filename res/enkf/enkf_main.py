@@ -247,7 +247,7 @@ class _RealEnKFMain(BaseCClass):
     )
     _get_mount_point = ResPrototype("char* enkf_main_get_mount_root( enkf_main )")
     _load_from_run_context = ResPrototype(
-        "int enkf_main_load_from_run_context(enkf_main, ert_run_context, enkf_fs)"
+        "int enkf_main_load_from_run_context(enkf_main, ert_run_context, enkf_fs, bool)"
     )
     _alloc_run_context_ENSEMBLE_EXPERIMENT = ResPrototype(
         "ert_run_context_obj enkf_main_alloc_ert_run_context_ENSEMBLE_EXPERIMENT(enkf_main , \
@@ -373,19 +373,35 @@ class _RealEnKFMain(BaseCClass):
         """@rtype: HookManager"""
         return self._get_hook_manager()
 
-    def loadFromForwardModel(self, realization: List[bool], iteration: int, fs):
-        """Returns the number of loaded realizations"""
+    def loadFromForwardModel(
+        self,
+        realization: List[bool],
+        iteration: int,
+        fs,
+        force_reload: bool = False,
+    ):
+        """Returns the number of loaded realizations
+
+        Results which are unchanged since they were last loaded into fs are
+        not loaded again, unless force_reload is True.
+        """
         true_indices = [idx for idx, value in enumerate(realization) if value]
         bool_vector = BoolVector.createFromList(
             size=len(realization), source_list=true_indices
         )
-        nr_loaded = enkf_main.load_from_forward_model(self, iteration, bool_vector, fs)
+        nr_loaded = enkf_main.load_from_forward_model(
+            self, iteration, bool_vector, fs, force_reload
+        )
         fs.sync()
         return nr_loaded
 
-    def loadFromRunContext(self, run_context, fs):
-        """Returns the number of loaded realizations"""
-        return self._load_from_run_context(run_context, fs)
+    def loadFromRunContext(self, run_context, fs, force_reload: bool = False):
+        """Returns the number of loaded realizations
+
+        Results which are unchanged since they were last loaded into fs are
+        not loaded again, unless force_reload is True.
+        """
+        return self._load_from_run_context(run_context, fs, force_reload)
 
     def initRun(self, run_context):
         enkf_main.init_internalization(self)
@@ -80,6 +80,12 @@ class EnsembleConfig(BaseCClass):
     _add_summary_full = ResPrototype(
         "void ensemble_config_init_SUMMARY_full(ens_config, char*, ecl_sum)"
     )
+    _set_summary_table = ResPrototype(
+        "void ensemble_config_set_summary_table(ens_config, bool)"
+    )
+    _use_summary_table = ResPrototype(
+        "bool ensemble_config_use_summary_table(ens_config)"
+    )
 
     def __init__(
         self,
@@ -159,6 +165,8 @@ class EnsembleConfig(BaseCClass):
                 )
                 self.addNode(surface_node)
 
+            self._set_summary_table(config_dict.get(ConfigKeys.SUMMARY_TABLE, False))
+
             summary_list = config_dict.get(ConfigKeys.SUMMARY, [])
             for a in summary_list:
                 self.add_summary_full(a, refcase)
@@ -272,10 +280,16 @@ class EnsembleConfig(BaseCClass):
         """@rtype: SummaryKeyMatcher"""
         return self._summary_key_matcher()
 
+    def useSummaryTable(self) -> bool:
+        return self._use_summary_table()
+
     def free(self):
         self._free()
 
     def __eq__(self, other):
+        if self.useSummaryTable() != other.useSummaryTable():
+            return False
+
         self_param_list = set(self.alloc_keylist())
         other_param_list = set(other.alloc_keylist())
         if self_param_list != other_param_list:
@@ -2,7 +2,7 @@ import logging
 import numpy as np
 from dataclasses import dataclass, field
 from pathlib import Path
-from typing import Dict, Any, TYPE_CHECKING, List
+from typing import Dict, Any, TYPE_CHECKING, List, Optional
 
 from ecl.util.util import RandomNumberGenerator
 from res.enkf.enums import RealizationStateEnum
@@ -50,9 +50,12 @@ def analysis_ES(
     ensemble_config: EnsembleConfig,
     source_fs: EnkfFs,
     target_fs: EnkfFs,
+    reduction: Optional[update.ObservationReduction] = None,
 ) -> None:
 
     iens_active_index = [i for i in range(len(ens_mask)) if ens_mask[i]]
+    if reduction is None:
+        reduction = update.ObservationReduction()
 
     update.copy_parameters(source_fs, target_fs, ensemble_config, ens_mask)
 
@@ -67,6 +70,7 @@ def analysis_ES(
             global_scaling,
             ens_mask,
             update_step.observation_config(),
+            reduction,
         )
         # pylint: disable=unsupported-assignment-operation
         smoother_snapshot.update_step_snapshots[
@@ -322,6 +326,7 @@ class ESUpdate:
             ensemble_config,
             source_fs,
             target_fs,
+            update.observation_reduction(analysis_config),
         )
 
         _write_update_report(
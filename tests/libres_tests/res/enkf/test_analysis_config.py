@@ -107,3 +107,17 @@ class AnalysisConfigTest(ResTest):
             analysis_config_file = AnalysisConfig(user_config_file=_config_file)
             analysis_config_dict = AnalysisConfig(config_dict=config_dict)
             self.assertEqual(analysis_config_dict, analysis_config_file)
+
+    def test_analysis_config_obs_reduction_from_dict(self):
+        with TestAreaContext("analysis_config_obs_reduction_test"):
+            analysis_config = AnalysisConfig(
+                config_dict={
+                    ConfigKeys.NUM_REALIZATIONS: 10,
+                    ConfigKeys.OBS_REDUCTION_MIN_SIZE: 20,
+                    ConfigKeys.OBS_REDUCTION_BLOCK_SIZE: 5,
+                    ConfigKeys.OBS_REDUCTION_VARIANCE: 0.9,
+                }
+            )
+            self.assertEqual(analysis_config.get_obs_reduction_min_size(), 20)
+            self.assertEqual(analysis_config.get_obs_reduction_block_size(), 5)
+            self.assertFloatEqual(analysis_config.get_obs_reduction_variance(), 0.9)
@@ -124,3 +124,75 @@ def test_load_forward_model(copy_data):
         facade.get_current_fs().getStateMap()[realisation_number].name
         == "STATE_HAS_DATA"
     )  # Check that status is as expected
+
+
+def test_load_forward_model_keeps_gen_data_active_mask(copy_data):
+    """
+    Checking that reloading a case where only some of the realizations have
+    changed results keeps the active mask of the GEN_DATA nodes
+    """
+    with fileinput.input("snake_oil.ert", inplace=True) as fin:
+        for line in fin:
+            if line.startswith("GEN_DATA") and "SNAKE_OIL_OPR_DIFF" not in line:
+                continue
+            print(line, end="")
+
+    runpath = Path("storage") / "snake_oil" / "runpath"
+    active = {0: [0, 1, 1, 1, 1], 1: [1, 1, 1, 1, 0], 2: None}
+    for iens, mask in active.items():
+        run_path = runpath / f"realization-{iens}" / "iter-0"
+        if iens > 0:
+            shutil.copytree(runpath / "realization-0" / "iter-0", run_path)
+        (run_path / "snake_oil_opr_diff_199.txt").write_text("1\n2\n3\n4\n5\n")
+        if mask:
+            (run_path / "snake_oil_opr_diff_199.txt_active").write_text(
+                "".join(f"{value}\n" for value in mask)
+            )
+
+    def load():
+        ert = EnKFMain(ResConfig("snake_oil.ert"))
+        facade = LibresFacade(ert)
+        realizations = [iens in active for iens in range(facade.get_ensemble_size())]
+        assert facade.load_from_forward_model("default_0", realizations, 0) == 3
+        config = ert.ensembleConfig()["SNAKE_OIL_OPR_DIFF"].getDataModelConfig()
+        return list(config.getActiveMask())
+
+    expected_mask = [False, True, True, True, False]
+    assert load() == expected_mask
+
+    # Only the results of realization 2 have changed
+    (runpath / "realization-2" / "iter-0" / "snake_oil_opr_diff_199.txt").write_text(
+        "5\n4\n3\n2\n1\n"
+    )
+    assert load() == expected_mask
+
+
+@pytest.mark.parametrize("force_reload", [False, True])
+def test_load_forward_model_unchanged_results(copy_data, caplog, force_reload):
+    """
+    Checking that unchanged results are only loaded again with force_reload
+    """
+    with fileinput.input("snake_oil.ert", inplace=True) as fin:
+        for line in fin:
+            if line.startswith("GEN_DATA"):
+                continue
+            print(line, end="")
+
+    res_config = ResConfig("snake_oil.ert")
+    ert = EnKFMain(res_config)
+    facade = LibresFacade(ert)
+    realizations = [False] * facade.get_ensemble_size()
+    realizations[0] = True
+    assert facade.load_from_forward_model("default_0", realizations, 0) == 1
+
+    unchanged = "[000:----] Summary results are unchanged - not loaded again."
+    caplog.clear()
+    with caplog.at_level(logging.INFO):
+        loaded = facade.load_from_forward_model(
+            "default_0", realizations, 0, force_reload=force_reload
+        )
+    assert loaded == 1
+    assert (unchanged in caplog.messages) != force_reload
+    assert (
+        facade.get_current_fs().getStateMap()[0].name == "STATE_HAS_DATA"
+    )  # Check that status is as expected